@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <cassert>
 #include <chrono>
@@ -29,22 +30,31 @@ void generate_benchmark_data(BenchmarkData& data, size_t count) {
 void benchmark_skip(const BenchmarkData& data) {
     std::cout << "--- Benchmarking SKIP ---" << std::endl;
 
-    auto start_enc = std::chrono::high_resolution_clock::now();
-
+    // Strings go to the heap of one skip_string field, so the config does
+    // not depend on the string contents. The schema is built once, outside
+    // the encode timing.
     void* config = skip_create_base_config();
     skip_push_type_to_config(config, skip_int32, data.integers.size());
     skip_push_type_to_config(config, skip_float64, data.doubles.size());
+    skip_push_type_to_config(config, skip_string, data.strings.size());
+
+    auto start_enc = std::chrono::high_resolution_clock::now();
+
+    uint64_t heap_size = 0;
     for (const auto& s : data.strings) {
-        skip_push_type_to_config(config, skip_char, s.length() + 1);
+        heap_size += s.length() + 1;
     }
-
-    uint64_t buffer_size = skip_get_data_size(config);
+    uint64_t buffer_size = skip_get_data_size(config) + heap_size;
     char* buffer = new char[buffer_size];
 
-    skip_write_index_to_buffer(config, buffer, buffer_size, (void*)data.integers.data(), 0);
-    skip_write_index_to_buffer(config, buffer, buffer_size, (void*)data.doubles.data(), 1);
+    SkipIoVec fields[2] = {
+        {(void*)data.integers.data(), data.integers.size() * sizeof(int32_t)},
+        {(void*)data.doubles.data(), data.doubles.size() * sizeof(double)},
+    };
+    skip_write_all(config, buffer, buffer_size, fields, 2);
+    uint64_t heap_used = 0;
     for (size_t i = 0; i < data.strings.size(); ++i) {
-        skip_write_index_to_buffer(config, buffer, buffer_size, (void*)data.strings[i].c_str(), 2 + i);
+        skip_write_var_element(config, buffer, buffer_size, &heap_used, 2, i, data.strings[i].data(), data.strings[i].length());
     }
 
     auto end_enc = std::chrono::high_resolution_clock::now();
@@ -58,9 +68,11 @@ void benchmark_skip(const BenchmarkData& data) {
 
     skip_read_index_from_buffer(config, buffer, buffer_size, decoded_data.integers.data(), 0);
     skip_read_index_from_buffer(config, buffer, buffer_size, decoded_data.doubles.data(), 1);
+    decoded_data.strings.reserve(data.strings.size());
     for (size_t i = 0; i < data.strings.size(); ++i) {
-        char* str_ptr = (char*)skip_get_index_ptr(config, buffer, 2 + i);
-        decoded_data.strings.push_back(str_ptr);
+        SkipIoVec str;
+        skip_read_var_element(config, buffer, buffer_size, 2, i, &str);
+        decoded_data.strings.emplace_back((const char*)str.base, str.len);
     }
 
     auto end_dec = std::chrono::high_resolution_clock::now();
@@ -161,6 +173,190 @@ void benchmark_xml(const BenchmarkData& data) {
     std::cout << "Decoding Time: " << dec_duration.count() << " ms" << std::endl;
 }
 
+// The per-element swap loop that skip_read_index_from_buffer used before the
+// bulk kernels, kept here as the baseline.
+static void reference_swap_loop(uint8_t* dst, const uint8_t* src, uint64_t type_size, uint64_t count) {
+    for (uint64_t i = 0; i < count; ++i) {
+        switch (type_size) {
+            case 4: {
+                uint32_t val;
+                memcpy(&val, src, 4);
+                val = ((val << 8) & 0xFF00FF00) | ((val >> 8) & 0xFF00FF);
+                val = (val << 16) | (val >> 16);
+                memcpy(dst, &val, 4);
+                break;
+            }
+            case 8: {
+                uint64_t val;
+                memcpy(&val, src, 8);
+                val = ((val << 8) & 0xFF00FF00FF00FF00ULL) | ((val >> 8) & 0x00FF00FF00FF00FFULL);
+                val = ((val << 16) & 0xFFFF0000FFFF0000ULL) | ((val >> 16) & 0x0000FFFF0000FFFFULL);
+                val = (val << 32) | (val >> 32);
+                memcpy(dst, &val, 8);
+                break;
+            }
+        }
+        src += type_size;
+        dst += type_size;
+    }
+}
+
+void benchmark_endian_swap(size_t count) {
+    std::cout << "--- Benchmarking Cross-Endian Swap (" << count << " elements) ---" << std::endl;
+
+    const char* level_names[] = {"scalar", "sse2", "avx2", "avx512"};
+    const uint64_t type_sizes[] = {4, 8};
+    const int rounds = 20;
+
+    std::vector<uint8_t> src(count * 8);
+    std::vector<uint8_t> dst(count * 8);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = (uint8_t)(i * 31);
+    }
+
+    std::cout << std::fixed << std::setprecision(6);
+    for (uint64_t type_size : type_sizes) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            reference_swap_loop(dst.data(), src.data(), type_size, count);
+        }
+        std::chrono::duration<double, std::milli> loop_duration = std::chrono::high_resolution_clock::now() - start;
+        std::cout << type_size * 8 << "-bit per-element loop: " << loop_duration.count() / rounds << " ms" << std::endl;
+
+        for (int level = SKIP_SIMD_SCALAR; level <= skip_get_simd_level(); ++level) {
+            start = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < rounds; ++r) {
+                skip_swap_elements(dst.data(), src.data(), type_size, count, level);
+            }
+            std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+            std::cout << type_size * 8 << "-bit " << level_names[level] << " kernel: " << duration.count() / rounds << " ms" << std::endl;
+        }
+    }
+}
+
+struct AllocationCounter {
+    uint64_t allocs = 0;
+};
+
+static void* counted_alloc(void* user, uint64_t size) {
+    ((AllocationCounter*)user)->allocs++;
+    return malloc(size);
+}
+
+static void* counted_realloc(void* user, void* ptr, uint64_t old_size, uint64_t new_size) {
+    (void)old_size;
+    ((AllocationCounter*)user)->allocs++;
+    return realloc(ptr, new_size);
+}
+
+static void counted_free(void* user, void* ptr, uint64_t size) {
+    (void)user;
+    (void)size;
+    free(ptr);
+}
+
+void benchmark_nest_buffer(size_t messages) {
+    std::cout << "--- Benchmarking Nested Message Build (" << messages << " messages) ---" << std::endl;
+
+    // The config is created under the counting allocator too, so anything
+    // it allocates during the loop is counted as well.
+    AllocationCounter counter;
+    SkipAllocator allocator = {counted_alloc, counted_realloc, counted_free, &counter};
+    skip_set_allocator(&allocator);
+
+    void* config = skip_create_base_config();
+    skip_push_type_to_config(config, skip_int64, 1);
+    skip_push_type_to_config(config, skip_float64, 4);
+    skip_push_type_to_config(config, skip_char, 16);
+
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> data(data_size, 1);
+    uint64_t nest_size = sizeof(uint64_t) + skip_get_export_header_body_size(config) + data_size;
+    std::vector<char> nest(nest_size);
+
+    // The nest buffer is built straight into the caller's memory, so this
+    // loop must not allocate.
+    counter.allocs = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < messages; ++i) {
+        skip_create_nest_buffer(config, nest.data(), nest_size, data.data(), data_size);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+    uint64_t loop_allocs = counter.allocs;
+
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << "Nest Size: " << nest_size << " bytes" << std::endl;
+    std::cout << "Build Time: " << duration.count() * 1e6 / messages << " ns/message" << std::endl;
+    std::cout << "Allocations: " << (double)loop_allocs / messages << " per message" << std::endl;
+    assert(loop_allocs == 0);
+
+    skip_free_cfg(config);
+    skip_set_allocator(NULL);
+}
+
+void benchmark_header_body_import(size_t imports) {
+    std::cout << "--- Benchmarking Header Body Import (" << imports << " imports) ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    for (int i = 0; i < 200; ++i) {
+        skip_push_type_to_config(config, i % 4 == 0 ? skip_float64 : skip_int32, 1);
+    }
+
+    std::cout << std::fixed << std::setprecision(6);
+    const int formats[] = {SKIP_HEADER_FORMAT_FIXED, SKIP_HEADER_FORMAT_COMPACT};
+    for (int format : formats) {
+        skip_set_header_format_cfg(config, format);
+        uint64_t body_size = skip_get_export_header_body_size(config);
+        std::vector<char> body(body_size);
+        skip_export_header_body(config, body.data(), body_size);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < imports; ++i) {
+            void* imported = skip_create_base_config();
+            skip_import_header_body(imported, body.data(), body_size);
+            skip_free_cfg(imported);
+        }
+        std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << (format == SKIP_HEADER_FORMAT_FIXED ? "Fixed" : "Compact") << " Body Size: " << body_size << " bytes" << std::endl;
+        std::cout << (format == SKIP_HEADER_FORMAT_FIXED ? "Fixed" : "Compact") << " Import Time: " << duration.count() * 1e6 / imports << " ns/import" << std::endl;
+    }
+
+    skip_free_cfg(config);
+}
+
+void benchmark_parallel_write(uint64_t element_count) {
+    std::cout << "--- Benchmarking Parallel Write All (" << element_count << " doubles) ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_float64, element_count);
+    skip_compile_config(config);
+
+    std::vector<double> values(element_count, 2.5);
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> buffer(data_size);
+    SkipIoVec field = {values.data(), data_size};
+
+    std::cout << std::fixed << std::setprecision(6);
+    const uint64_t thread_counts[] = {1, 2, 4, 8};
+    for (uint64_t threads : thread_counts) {
+        void* pool = skip_create_thread_pool(threads);
+        skip_write_all_parallel(pool, config, buffer.data(), data_size, &field, 1);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) {
+            skip_write_all_parallel(pool, config, buffer.data(), data_size, &field, 1);
+        }
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << threads << " Threads: " << (data_size * 10 / duration.count()) / 1e9 << " GB/s" << std::endl;
+        skip_free_thread_pool(pool);
+    }
+
+    skip_free_cfg(config);
+}
+
 int main() {
     BenchmarkData data;
     generate_benchmark_data(data, 1000);
@@ -170,6 +366,14 @@ int main() {
     benchmark_json(data);
     std::cout << std::endl;
     benchmark_xml(data);
+    std::cout << std::endl;
+    benchmark_endian_swap(500000);
+    std::cout << std::endl;
+    benchmark_nest_buffer(100000);
+    std::cout << std::endl;
+    benchmark_header_body_import(20000);
+    std::cout << std::endl;
+    benchmark_parallel_write(32 * 1024 * 1024);
 
     return 0;
 }
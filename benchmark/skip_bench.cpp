@@ -0,0 +1,507 @@
+// Offline benchmark suite for SKIP. It depends only on the library, so it
+// builds without network access, and it times the library calls alone:
+// configs and buffers are prepared outside the timed region.
+//
+// Every case runs warmup trials followed by measured trials. Each trial times
+// enough iterations to last at least --min-trial-ms, and reports the
+// percentiles of the per-operation time over the trials. --json writes the
+// results for later runs to --compare against.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "skip.h"
+
+struct BenchOptions {
+    uint64_t min_size = 64;
+    uint64_t max_size = 64ull << 20;
+    int trials = 15;
+    int warmup = 3;
+    double min_trial_ms = 2.0;
+    std::string filter;
+    std::string json_path;
+    std::string compare_path;
+    double threshold = 0.10;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t bytes = 0;
+    uint64_t iterations = 0;
+    double min_ns = 0;
+    double p50_ns = 0;
+    double p90_ns = 0;
+    double p99_ns = 0;
+    double max_ns = 0;
+    double mean_ns = 0;
+};
+
+typedef std::chrono::steady_clock BenchClock;
+
+// With --json=- stdout carries only the JSON, so the human-readable tables
+// go to stderr.
+static std::ostream& report_stream(const BenchOptions& options) {
+    return options.json_path == "-" ? std::cerr : std::cout;
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.size() == 1) {
+        return sorted[0];
+    }
+
+    double rank = p * (double)(sorted.size() - 1);
+    size_t low = (size_t)rank;
+    size_t high = std::min(low + 1, sorted.size() - 1);
+    return sorted[low] + (sorted[high] - sorted[low]) * (rank - (double)low);
+}
+
+static double time_iterations(const std::function<void()>& op, uint64_t iterations) {
+    BenchClock::time_point start = BenchClock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        op();
+    }
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options) : options_(options) {}
+
+    bool wants(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // bytes is the payload processed by one call of op; 0 for cases where a
+    // throughput figure makes no sense.
+    void run(const std::string& name, uint64_t bytes, const std::function<void()>& op) {
+        if (!wants(name)) {
+            return;
+        }
+
+        // Doubling also warms caches and page mappings before the
+        // iteration count is fixed.
+        double target_ns = options_.min_trial_ms * 1e6;
+        uint64_t iterations = 1;
+        while (time_iterations(op, iterations) < target_ns && iterations < 10000000) {
+            iterations *= 2;
+        }
+
+        for (int i = 0; i < options_.warmup; ++i) {
+            time_iterations(op, iterations);
+        }
+
+        std::vector<double> samples;
+        double total = 0;
+        for (int i = 0; i < options_.trials; ++i) {
+            double ns = time_iterations(op, iterations) / (double)iterations;
+            samples.push_back(ns);
+            total += ns;
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = name;
+        result.bytes = bytes;
+        result.iterations = iterations;
+        result.min_ns = samples.front();
+        result.p50_ns = percentile(samples, 0.50);
+        result.p90_ns = percentile(samples, 0.90);
+        result.p99_ns = percentile(samples, 0.99);
+        result.max_ns = samples.back();
+        result.mean_ns = total / (double)samples.size();
+        results_.push_back(result);
+        print(result);
+    }
+
+    const std::vector<BenchResult>& results() const {
+        return results_;
+    }
+
+    void print_heading() const {
+        report_stream(options_) << std::left << std::setw(48) << "name" << std::right
+                  << std::setw(12) << "bytes" << std::setw(10) << "iters"
+                  << std::setw(14) << "p50 ns" << std::setw(14) << "p90 ns"
+                  << std::setw(14) << "p99 ns" << std::setw(12) << "GB/s" << std::endl;
+    }
+
+private:
+    void print(const BenchResult& result) const {
+        std::ostream& out = report_stream(options_);
+        out << std::left << std::setw(48) << result.name << std::right
+                  << std::setw(12) << result.bytes << std::setw(10) << result.iterations
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << result.p50_ns << std::setw(14) << result.p90_ns
+                  << std::setw(14) << result.p99_ns << std::setprecision(3) << std::setw(12);
+        if (result.bytes) {
+            out << (double)result.bytes / result.p50_ns;
+        } else {
+            out << "-";
+        }
+        out << std::endl;
+    }
+
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+static int other_endian() {
+    return skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN;
+}
+
+static const char* endian_label(int endian) {
+    return endian == skip_get_system_endian() ? "same" : "cross";
+}
+
+// Splits payload_bytes over field_count fields of mixed element types.
+static void* build_payload_config(uint64_t payload_bytes, uint64_t field_count, int endian) {
+    static const int32_t types[] = {skip_float64, skip_int32, skip_uint16, skip_int64, skip_uint8, skip_float32};
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, endian);
+
+    uint64_t per_field = payload_bytes / field_count;
+    for (uint64_t i = 0; i < field_count; ++i) {
+        int32_t type = types[i % (sizeof(types) / sizeof(types[0]))];
+        uint64_t count = std::max<uint64_t>(per_field / skip_get_datatype_size(type), 1);
+        skip_push_type_to_config(config, type, count);
+    }
+
+    skip_compile_config(config);
+    return config;
+}
+
+static std::vector<SkipIoVec> field_views(void* config, std::vector<char>& storage) {
+    std::vector<SkipIoVec> fields;
+    uint64_t offset = 0;
+    for (uint64_t i = 0; SkipInternalType* type = skip_get_type_at_index(config, i); ++i) {
+        uint64_t size = skip_get_datatype_size(type->type_code) * type->count;
+        fields.push_back({storage.data() + offset, size});
+        offset += size;
+    }
+    return fields;
+}
+
+static std::string case_name(const std::string& base, const char* key, uint64_t value) {
+    std::ostringstream name;
+    name << base << "/" << key << ":" << value;
+    return name.str();
+}
+
+static void bench_transfers(BenchRunner& runner, const BenchOptions& options) {
+    const uint64_t field_counts[] = {1, 16, 256};
+    const int endians[] = {skip_get_system_endian(), other_endian()};
+
+    for (uint64_t size = options.min_size; size <= options.max_size; size *= 16) {
+        for (uint64_t fields : field_counts) {
+            if (size / fields < 8) {
+                continue;
+            }
+
+            for (int endian : endians) {
+                std::string suffix = std::string(endian_label(endian)) + "/fields:" + std::to_string(fields) + "/bytes:" + std::to_string(size);
+                std::string write_name = "write_all/" + suffix;
+                std::string read_name = "read_all/" + suffix;
+                if (!runner.wants(write_name) && !runner.wants(read_name)) {
+                    continue;
+                }
+
+                void* config = build_payload_config(size, fields, endian);
+                uint64_t data_size = skip_get_data_size(config);
+                std::vector<char> values(data_size, 0x5A);
+                std::vector<char> buffer(data_size);
+                std::vector<SkipIoVec> io = field_views(config, values);
+
+                runner.run(write_name, data_size, [&]() {
+                    skip_write_all(config, buffer.data(), data_size, io.data(), io.size());
+                });
+                runner.run(read_name, data_size, [&]() {
+                    skip_read_all(config, buffer.data(), data_size, io.data(), io.size());
+                });
+
+                skip_free_cfg(config);
+            }
+        }
+    }
+}
+
+static void bench_nested(BenchRunner& runner, const BenchOptions& options) {
+    for (uint64_t size = options.min_size; size <= options.max_size; size *= 16) {
+        std::string build_name = case_name("nest/build", "bytes", size);
+        std::string decode_name = case_name("nest/decode", "bytes", size);
+        if (!runner.wants(build_name) && !runner.wants(decode_name)) {
+            continue;
+        }
+
+        void* config = build_payload_config(size, 16 < size / 8 ? 16 : 1, skip_get_system_endian());
+        uint64_t data_size = skip_get_data_size(config);
+        std::vector<char> data(data_size, 1);
+        std::vector<char> decoded(data_size);
+        uint64_t nest_size = sizeof(uint64_t) + skip_get_export_header_body_size(config) + data_size;
+        std::vector<char> nest(nest_size);
+
+        runner.run(build_name, nest_size, [&]() {
+            skip_create_nest_buffer(config, nest.data(), nest_size, data.data(), data_size);
+        });
+        runner.run(decode_name, nest_size, [&]() {
+            void* nested = skip_create_base_config();
+            skip_get_nest_cfg(config, nested, nest.data(), nest_size);
+            skip_get_nested_data_buffer(config, nest.data(), nest_size, decoded.data(), data_size);
+            skip_free_cfg(nested);
+        });
+
+        skip_free_cfg(config);
+    }
+}
+
+static void bench_standalone(BenchRunner& runner, const BenchOptions& options) {
+    for (uint64_t size = options.min_size; size <= options.max_size; size *= 16) {
+        std::string export_name = case_name("standalone/export", "bytes", size);
+        std::string import_name = case_name("standalone/import", "bytes", size);
+        if (!runner.wants(export_name) && !runner.wants(import_name)) {
+            continue;
+        }
+
+        void* config = build_payload_config(size, 16 < size / 8 ? 16 : 1, other_endian());
+        uint64_t data_size = skip_get_data_size(config);
+        std::vector<char> data(data_size, 1);
+        std::vector<char> decoded(data_size);
+        uint64_t standalone_size = skip_export_standalone_size(config);
+        std::vector<char> standalone(standalone_size);
+
+        runner.run(export_name, standalone_size, [&]() {
+            skip_export_standalone(config, data.data(), data_size, standalone.data(), standalone_size);
+        });
+        runner.run(import_name, standalone_size, [&]() {
+            void* imported = NULL;
+            skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size);
+            skip_import_standalone_get_data_buffer(imported, standalone.data(), standalone_size, decoded.data(), data_size);
+            skip_free_cfg(imported);
+        });
+
+        skip_free_cfg(config);
+    }
+}
+
+static void bench_config_import(BenchRunner& runner) {
+    const uint64_t field_counts[] = {16, 256, 4096};
+    for (uint64_t fields : field_counts) {
+        void* config = skip_create_base_config();
+        for (uint64_t i = 0; i < fields; ++i) {
+            skip_push_type_to_config(config, i % 4 == 0 ? skip_float64 : skip_int32, 1);
+        }
+
+        const int formats[] = {SKIP_HEADER_FORMAT_FIXED, SKIP_HEADER_FORMAT_COMPACT};
+        for (int format : formats) {
+            skip_set_header_format_cfg(config, format);
+            uint64_t body_size = skip_get_export_header_body_size(config);
+            std::vector<char> body(body_size);
+            skip_export_header_body(config, body.data(), body_size);
+
+            std::string base = format == SKIP_HEADER_FORMAT_FIXED ? "config_import/fixed" : "config_import/compact";
+            runner.run(case_name(base, "fields", fields), body_size, [&]() {
+                void* imported = skip_create_base_config();
+                skip_import_header_body(imported, body.data(), body_size);
+                skip_free_cfg(imported);
+            });
+        }
+
+        // A warm cache returns the shared config without decoding the table.
+        skip_set_header_format_cfg(config, SKIP_HEADER_FORMAT_FIXED);
+        uint64_t body_size = skip_get_export_header_body_size(config);
+        std::vector<char> body(body_size);
+        skip_export_header_body(config, body.data(), body_size);
+        void* cache = skip_create_config_cache(0);
+        int endian = skip_get_cfg_endian(config);
+        runner.run(case_name("config_import/cache_hit", "fields", fields), body_size, [&]() {
+            void* imported = NULL;
+            skip_config_cache_import_header_body(cache, &imported, endian, SKIP_LAYOUT_ROWS, body.data(), body_size);
+            skip_free_cfg(imported);
+        });
+
+        skip_free_config_cache(cache);
+        skip_free_cfg(config);
+    }
+}
+
+static void bench_field_index(BenchRunner& runner) {
+    const uint64_t field_counts[] = {16, 256, 4096};
+    for (uint64_t fields : field_counts) {
+        void* config = skip_create_base_config();
+        std::vector<std::string> names;
+        for (uint64_t i = 0; i < fields; ++i) {
+            names.push_back("field_" + std::to_string(i));
+            skip_push_named_type_to_config(config, names.back().c_str(), skip_int32, 1);
+        }
+        skip_compile_config(config);
+
+        uint64_t next = 0;
+        runner.run(case_name("field_index", "fields", fields), 0, [&]() {
+            const std::string& name = names[next];
+            skip_field_index_n(config, name.data(), name.size());
+            next = next + 1 == fields ? 0 : next + 1;
+        });
+
+        skip_free_cfg(config);
+    }
+}
+
+static void write_json(const BenchOptions& options, const std::vector<BenchResult>& results, std::ostream& out) {
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    // One benchmark per line keeps the file easy to diff and to read back.
+    out << "{\n  \"context\": {\"date\": \"" << date << "\", \"host_endian\": \""
+        << (skip_get_system_endian() == SKIP_LITTLE_ENDIAN ? "little" : "big")
+        << "\", \"simd_level\": " << skip_get_simd_level()
+        << ", \"trials\": " << options.trials << ", \"warmup\": " << options.warmup
+        << ", \"min_trial_ms\": " << options.min_trial_ms << "},\n  \"benchmarks\": [\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"bytes\": " << r.bytes
+            << ", \"iterations\": " << r.iterations << ", \"min_ns\": " << r.min_ns
+            << ", \"p50_ns\": " << r.p50_ns << ", \"p90_ns\": " << r.p90_ns
+            << ", \"p99_ns\": " << r.p99_ns << ", \"max_ns\": " << r.max_ns
+            << ", \"mean_ns\": " << r.mean_ns << ", \"bytes_per_second\": "
+            << (r.bytes ? (double)r.bytes * 1e9 / r.p50_ns : 0.0) << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Reads name -> p50_ns from a file written by write_json.
+static int read_baseline(const std::string& path, std::map<std::string, double>& out) {
+    std::ifstream file(path);
+    if (!file) {
+        return SKIP_ERROR_IO_FAILED;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t name = line.find("\"name\": \"");
+        size_t p50 = line.find("\"p50_ns\": ");
+        if (name == std::string::npos || p50 == std::string::npos) {
+            continue;
+        }
+
+        name += 9;
+        size_t name_end = line.find('"', name);
+        out[line.substr(name, name_end - name)] = strtod(line.c_str() + p50 + 10, NULL);
+    }
+
+    return SKIP_SUCCESS;
+}
+
+// Returns the number of cases slower than the baseline by more than the
+// threshold.
+static int compare_results(const BenchOptions& options, const std::vector<BenchResult>& results) {
+    std::map<std::string, double> baseline;
+    if (read_baseline(options.compare_path, baseline) != SKIP_SUCCESS) {
+        std::cerr << "cannot read baseline " << options.compare_path << std::endl;
+        return -1;
+    }
+
+    int regressions = 0;
+    std::ostream& out = report_stream(options);
+    out << std::endl << "Comparison against " << options.compare_path << " (p50):" << std::endl;
+    for (const BenchResult& r : results) {
+        std::map<std::string, double>::const_iterator it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+
+        double ratio = r.p50_ns / it->second;
+        bool regressed = ratio > 1.0 + options.threshold;
+        regressions += regressed;
+        out << std::left << std::setw(48) << r.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << ratio << "x" << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+
+    return regressions;
+}
+
+static uint64_t parse_size(const char* text) {
+    char* end = NULL;
+    uint64_t value = strtoull(text, &end, 10);
+    switch (*end) {
+        case 'K': case 'k': return value << 10;
+        case 'M': case 'm': return value << 20;
+        case 'G': case 'g': return value << 30;
+        default: return value;
+    }
+}
+
+static void usage() {
+    std::cout << "usage: skip_bench [--min-size=N] [--max-size=N] [--trials=N] [--warmup=N]\n"
+                 "                  [--min-trial-ms=X] [--filter=SUBSTR] [--json=PATH]\n"
+                 "                  [--compare=PATH] [--threshold=X]\n"
+                 "Sizes accept K, M and G suffixes; sizes grow by 16x from --min-size.\n"
+                 "Use --max-size=1G for the full sweep.\n";
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        const char* value = eq == std::string::npos ? "" : argv[i] + eq + 1;
+
+        if (key == "--min-size") options.min_size = std::max<uint64_t>(parse_size(value), 8);
+        else if (key == "--max-size") options.max_size = parse_size(value);
+        else if (key == "--trials") options.trials = std::max(atoi(value), 1);
+        else if (key == "--warmup") options.warmup = std::max(atoi(value), 0);
+        else if (key == "--min-trial-ms") options.min_trial_ms = atof(value);
+        else if (key == "--filter") options.filter = value;
+        else if (key == "--json") options.json_path = value;
+        else if (key == "--compare") options.compare_path = value;
+        else if (key == "--threshold") options.threshold = atof(value);
+        else {
+            usage();
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+
+    BenchRunner runner(options);
+    runner.print_heading();
+    bench_transfers(runner, options);
+    bench_nested(runner, options);
+    bench_standalone(runner, options);
+    bench_config_import(runner);
+    bench_field_index(runner);
+
+    if (!options.json_path.empty()) {
+        if (options.json_path == "-") {
+            write_json(options, runner.results(), std::cout);
+        } else {
+            std::ofstream file(options.json_path);
+            write_json(options, runner.results(), file);
+            if (!file) {
+                std::cerr << "cannot write " << options.json_path << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (!options.compare_path.empty()) {
+        int regressions = compare_results(options, runner.results());
+        if (regressions != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
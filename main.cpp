@@ -2,7 +2,20 @@
 #include <cstdint>
 #include <cstring>
 #include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
 #include "skip.h"
+#include "skip.hpp"
+
+static uint32_t swap_u32_for_test(uint32_t val) {
+    return (val >> 24) | ((val >> 8) & 0xFF00) | ((val << 8) & 0xFF0000) | (val << 24);
+}
 
 void test_new_datatypes() {
     std::cout << "--- Testing New Data Types ---" << std::endl;
@@ -328,7 +341,2108 @@ void test_endianness_config() {
     std::cout << "--- Test Passed ---" << std::endl << std::endl;
 }
 
+void test_simd_swap_kernels() {
+    std::cout << "--- Testing SIMD Swap Kernels ---" << std::endl;
+
+    const uint64_t max_count = 131;
+    uint64_t src[max_count];
+    for (uint64_t i = 0; i < max_count; ++i) {
+        src[i] = 0x0102030405060708ULL * (i + 1);
+    }
+
+    uint64_t expected[max_count];
+    uint64_t actual[max_count];
+    const uint64_t sizes[] = {1, 2, 4, 8};
+    for (uint64_t type_size : sizes) {
+        uint64_t count = (max_count * 8) / type_size;
+        for (uint64_t n = 0; n <= count; n += (n < 80 ? 1 : 37)) {
+            assert(skip_swap_elements(expected, src, type_size, n, SKIP_SIMD_SCALAR) == SKIP_SUCCESS);
+            for (int level = SKIP_SIMD_SSE2; level <= skip_get_simd_level(); ++level) {
+                memset(actual, 0, sizeof(actual));
+                assert(skip_swap_elements(actual, src, type_size, n, level) == SKIP_SUCCESS);
+                assert(memcmp(actual, expected, (size_t)(n * type_size)) == 0);
+            }
+        }
+    }
+    std::cout << "All kernels up to level " << skip_get_simd_level() << " match the scalar swap." << std::endl;
+
+    uint32_t word = 0x12345678;
+    assert(skip_swap_elements(&word, &word, 4, 1, SKIP_SIMD_AUTO) == SKIP_SUCCESS);
+    assert(word == 0x78563412);
+    assert(skip_swap_elements(&word, &word, 4, 1, SKIP_SIMD_AVX512 + 1) == SKIP_ERROR_INVALID_ARGUMENT);
+
+    // Cross-endian round trip over a field long enough to hit the vector loops.
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_LITTLE_ENDIAN ? SKIP_BIG_ENDIAN : SKIP_LITTLE_ENDIAN);
+    skip_push_type_to_config(config, skip_int32, 1001);
+    skip_push_type_to_config(config, skip_float64, 333);
+
+    uint64_t buffer_size = skip_get_data_size(config);
+    char* buffer = new char[buffer_size];
+
+    int32_t ints[1001], ints_res[1001];
+    double doubles[333], doubles_res[333];
+    for (int i = 0; i < 1001; ++i) ints[i] = i * 7919 - 500000;
+    for (int i = 0; i < 333; ++i) doubles[i] = i * 0.25 - 10.0;
+
+    assert(skip_write_index_to_buffer(config, buffer, buffer_size, ints, 0) == SKIP_SUCCESS);
+    assert(skip_write_index_to_buffer(config, buffer, buffer_size, doubles, 1) == SKIP_SUCCESS);
+
+    uint32_t first_raw;
+    memcpy(&first_raw, buffer + 4, 4);
+    assert(first_raw == swap_u32_for_test((uint32_t)ints[1]));
+
+    assert(skip_read_index_from_buffer(config, buffer, buffer_size, ints_res, 0) == SKIP_SUCCESS);
+    assert(skip_read_index_from_buffer(config, buffer, buffer_size, doubles_res, 1) == SKIP_SUCCESS);
+    assert(memcmp(ints, ints_res, sizeof(ints)) == 0);
+    assert(memcmp(doubles, doubles_res, sizeof(doubles)) == 0);
+    std::cout << "Cross-endian round trip is correct." << std::endl;
+
+    skip_free_cfg(config);
+    delete[] buffer;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_compiled_config() {
+    std::cout << "--- Testing Compiled Config ---" << std::endl;
+
+    const int endians[] = {SKIP_LITTLE_ENDIAN, SKIP_BIG_ENDIAN};
+    for (int endian : endians) {
+        void* plain = skip_create_base_config();
+        void* compiled = skip_create_base_config();
+        void* configs[] = {plain, compiled};
+        for (void* config : configs) {
+            skip_set_endian_value_cfg(config, endian);
+            skip_push_type_to_config(config, skip_uint16, 3);
+            skip_push_type_to_config(config, skip_char, 5);
+            skip_push_type_to_config(config, skip_float64, 2);
+        }
+
+        assert(skip_is_config_compiled(compiled) == 0);
+        assert(skip_compile_config(compiled) == SKIP_SUCCESS);
+        assert(skip_is_config_compiled(compiled) == 1);
+
+        uint64_t buffer_size = skip_get_data_size(plain);
+        char* plain_buffer = new char[buffer_size];
+        char* compiled_buffer = new char[buffer_size];
+
+        uint16_t shorts[3] = {1, 0x1234, 0xFFEE};
+        char text[5] = {'s', 'k', 'i', 'p', '\0'};
+        double doubles[2] = {-1.5, 1e300};
+        for (void* config : configs) {
+            char* buffer = config == plain ? plain_buffer : compiled_buffer;
+            assert(skip_write_index_to_buffer(config, buffer, buffer_size, shorts, 0) == SKIP_SUCCESS);
+            assert(skip_write_index_to_buffer(config, buffer, buffer_size, text, 1) == SKIP_SUCCESS);
+            assert(skip_write_index_to_buffer(config, buffer, buffer_size, doubles, 2) == SKIP_SUCCESS);
+        }
+        assert(memcmp(plain_buffer, compiled_buffer, buffer_size) == 0);
+
+        double doubles_res[2];
+        assert(skip_read_index_from_buffer(compiled, compiled_buffer, buffer_size, doubles_res, 2) == SKIP_SUCCESS);
+        assert(doubles_res[0] == doubles[0] && doubles_res[1] == doubles[1]);
+        assert(skip_read_index_from_buffer(compiled, compiled_buffer, buffer_size - 1, doubles_res, 2) == SKIP_ERROR_BUFFER_TOO_SMALL);
+
+        // Changing the config drops the plan until it is compiled again.
+        skip_push_type_to_config(compiled, skip_int32, 1);
+        assert(skip_is_config_compiled(compiled) == 0);
+        assert(skip_compile_config(compiled) == SKIP_SUCCESS);
+        skip_set_endian_value_cfg(compiled, endian);
+        assert(skip_is_config_compiled(compiled) == 0);
+
+        skip_free_cfg(plain);
+        skip_free_cfg(compiled);
+        delete[] plain_buffer;
+        delete[] compiled_buffer;
+    }
+    std::cout << "Compiled and uncompiled configs produce identical buffers." << std::endl;
+
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_write_read_all() {
+    std::cout << "--- Testing Whole-Record Write/Read ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_int32, 4);
+    skip_push_type_to_config(config, skip_char, 6);
+    skip_push_type_to_config(config, skip_float64, 1);
+
+    uint64_t buffer_size = skip_get_data_size(config);
+    char* buffer = new char[buffer_size];
+    char* expected = new char[buffer_size];
+
+    int32_t ints[4] = {1, -2, 3, -4};
+    char name[6] = {'h', 'e', 'l', 'l', 'o', '\0'};
+    double ratio = 0.125;
+
+    assert(skip_write_index_to_buffer(config, expected, buffer_size, ints, 0) == SKIP_SUCCESS);
+    assert(skip_write_index_to_buffer(config, expected, buffer_size, name, 1) == SKIP_SUCCESS);
+    assert(skip_write_index_to_buffer(config, expected, buffer_size, &ratio, 2) == SKIP_SUCCESS);
+
+    SkipIoVec fields[3] = {{ints, sizeof(ints)}, {name, sizeof(name)}, {&ratio, sizeof(ratio)}};
+    for (int compiled = 0; compiled < 2; ++compiled) {
+        if (compiled) {
+            skip_compile_config(config);
+        }
+        memset(buffer, 0, buffer_size);
+        assert(skip_write_all(config, buffer, buffer_size, fields, 3) == SKIP_SUCCESS);
+        assert(memcmp(buffer, expected, buffer_size) == 0);
+
+        int32_t ints_res[4];
+        double ratio_res = 0;
+        SkipIoVec out[3] = {{ints_res, sizeof(ints_res)}, {NULL, 0}, {&ratio_res, sizeof(ratio_res)}};
+        assert(skip_read_all(config, buffer, buffer_size, out, 3) == SKIP_SUCCESS);
+        assert(memcmp(ints, ints_res, sizeof(ints)) == 0);
+        assert(ratio_res == ratio);
+    }
+    std::cout << "Batch encode matches per-field encode." << std::endl;
+
+    assert(skip_write_all(config, buffer, buffer_size - 1, fields, 3) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_write_all(config, buffer, buffer_size, fields, 2) == SKIP_ERROR_INVALID_ARGUMENT);
+    SkipIoVec short_fields[3] = {{ints, sizeof(ints) - 1}, {name, sizeof(name)}, {&ratio, sizeof(ratio)}};
+    assert(skip_write_all(config, buffer, buffer_size, short_fields, 3) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    std::cout << "Bounds checks passed." << std::endl;
+
+    skip_free_cfg(config);
+    delete[] buffer;
+    delete[] expected;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+struct TestTick {
+    char symbol[8];
+    double price;
+    int32_t volume;
+    uint16_t flags;
+};
+
+void test_struct_map() {
+    std::cout << "--- Testing Struct Mapping ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_int32, 1);   // volume
+    skip_push_type_to_config(config, skip_char, 8);    // symbol
+    skip_push_type_to_config(config, skip_float64, 1); // price
+    skip_push_type_to_config(config, skip_uint16, 1);  // flags
+
+    SkipStructMember members[] = {
+        {0, offsetof(TestTick, volume)},
+        {1, offsetof(TestTick, symbol)},
+        {2, offsetof(TestTick, price)},
+        {3, offsetof(TestTick, flags)},
+    };
+    void* map = skip_create_struct_map(config, members, 4, sizeof(TestTick));
+    assert(map != nullptr);
+    assert(skip_get_struct_map_record_size(map) == skip_get_data_size(config));
+
+    const uint64_t count = 3;
+    TestTick ticks[count] = {
+        {"AAPL", 189.25, 100, 1},
+        {"MSFT", 402.5, -7, 2},
+        {"GOOG", 141.0, 65536, 0xBEEF},
+    };
+
+    uint64_t record_size = skip_get_data_size(config);
+    uint64_t buffer_size = record_size * count;
+    char* buffer = new char[buffer_size];
+    assert(skip_struct_write(map, buffer, buffer_size, ticks, count) == SKIP_SUCCESS);
+
+    // The second record must decode the same through the per-field API.
+    double price;
+    assert(skip_read_index_from_buffer(config, buffer + record_size, record_size, &price, 2) == SKIP_SUCCESS);
+    assert(price == 402.5);
+
+    TestTick decoded[count];
+    memset(decoded, 0, sizeof(decoded));
+    assert(skip_struct_read(map, buffer, buffer_size, decoded, count) == SKIP_SUCCESS);
+    for (uint64_t i = 0; i < count; ++i) {
+        assert(strcmp(decoded[i].symbol, ticks[i].symbol) == 0);
+        assert(decoded[i].price == ticks[i].price);
+        assert(decoded[i].volume == ticks[i].volume);
+        assert(decoded[i].flags == ticks[i].flags);
+    }
+    std::cout << "Structs round trip through a big-endian buffer." << std::endl;
+
+    assert(skip_struct_read(map, buffer, buffer_size - 1, decoded, count) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    SkipStructMember bad_offset[] = {{2, sizeof(TestTick) - 4}};
+    assert(skip_create_struct_map(config, bad_offset, 1, sizeof(TestTick)) == nullptr);
+    SkipStructMember bad_index[] = {{4, 0}};
+    assert(skip_create_struct_map(config, bad_index, 1, sizeof(TestTick)) == nullptr);
+    std::cout << "Invalid layouts are rejected." << std::endl;
+
+    skip_free_struct_map(map);
+    skip_free_cfg(config);
+    delete[] buffer;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_record_array() {
+    std::cout << "--- Testing Record Arrays ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_int32, 1);
+    skip_push_type_to_config(config, skip_float64, 1);
+    skip_push_type_to_config(config, skip_char, 3);
+    skip_push_type_to_config(config, skip_uint16, 2);
+
+    const uint64_t stride = skip_get_data_size(config);
+    assert(stride == 4 + 8 + 3 + 4);
+
+    // Host-order records packed with the same layout as the config.
+    const uint64_t count = 700;
+    char* records = new char[stride * count];
+    for (uint64_t r = 0; r < count; ++r) {
+        int32_t id = (int32_t)r - 350;
+        double value = r * 1.5;
+        uint16_t pair[2] = {(uint16_t)r, (uint16_t)(r * 3)};
+        memcpy(records + r * stride, &id, 4);
+        memcpy(records + r * stride + 4, &value, 8);
+        memcpy(records + r * stride + 12, "abc", 3);
+        memcpy(records + r * stride + 15, pair, 4);
+    }
+
+    uint64_t buffer_size = skip_get_record_array_size(config, count);
+    assert(buffer_size == 8 + stride * count);
+    char* buffer = new char[buffer_size];
+    assert(skip_init_record_array(config, buffer, buffer_size, count) == SKIP_SUCCESS);
+
+    uint64_t stored_count = 0;
+    assert(skip_get_record_array_count(config, buffer, buffer_size, &stored_count) == SKIP_SUCCESS);
+    assert(stored_count == count);
+
+    // Encode in two ranges to exercise the offset handling.
+    assert(skip_write_records(config, buffer, buffer_size, records, 0, 300) == SKIP_SUCCESS);
+    assert(skip_write_records(config, buffer, buffer_size, records + 300 * stride, 300, count - 300) == SKIP_SUCCESS);
+    assert(skip_write_records(config, buffer, buffer_size, records, 600, 101) == SKIP_ERROR_OUT_OF_BOUNDS);
+
+    void* record = skip_get_record_ptr(config, buffer, buffer_size, 123);
+    assert(record != nullptr);
+    double value;
+    assert(skip_read_index_from_buffer(config, record, stride, &value, 1) == SKIP_SUCCESS);
+    assert(value == 123 * 1.5);
+    assert(skip_get_record_ptr(config, buffer, buffer_size, count) == nullptr);
+
+    char* decoded = new char[stride * count];
+    assert(skip_read_records(config, buffer, buffer_size, decoded, 0, count) == SKIP_SUCCESS);
+    assert(memcmp(decoded, records, stride * count) == 0);
+    std::cout << "Records round trip in ranges." << std::endl;
+
+    double values[count];
+    assert(skip_read_record_column(config, buffer, buffer_size, 1, 0, count, values) == SKIP_SUCCESS);
+    uint16_t pairs[2 * 10];
+    assert(skip_read_record_column(config, buffer, buffer_size, 3, 690, 10, pairs) == SKIP_SUCCESS);
+    for (uint64_t r = 0; r < count; ++r) {
+        assert(values[r] == r * 1.5);
+    }
+    for (uint64_t r = 0; r < 10; ++r) {
+        assert(pairs[2 * r] == (uint16_t)(690 + r));
+        assert(pairs[2 * r + 1] == (uint16_t)((690 + r) * 3));
+    }
+    std::cout << "Column extraction is correct." << std::endl;
+
+    assert(skip_get_record_array_count(config, buffer, buffer_size - 1, &stored_count) == SKIP_ERROR_BUFFER_TOO_SMALL);
+
+    skip_free_cfg(config);
+    delete[] records;
+    delete[] decoded;
+    delete[] buffer;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_columnar_records() {
+    std::cout << "--- Testing Columnar Record Arrays ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    assert(skip_set_record_layout_cfg(config, SKIP_LAYOUT_COLUMNS) == SKIP_SUCCESS);
+    assert(skip_set_record_layout_cfg(config, 7) == SKIP_ERROR_INVALID_ARGUMENT);
+    assert(skip_get_record_layout_cfg(config) == SKIP_LAYOUT_COLUMNS);
+    skip_push_type_to_config(config, skip_uint32, 1);
+    skip_push_type_to_config(config, skip_char, 2);
+    skip_push_type_to_config(config, skip_float64, 1);
+
+    const uint64_t stride = skip_get_data_size(config);
+    const uint64_t count = 1500;
+    char* records = new char[stride * count];
+    for (uint64_t r = 0; r < count; ++r) {
+        uint32_t id = (uint32_t)(r * 2654435761u);
+        double value = r * -0.5;
+        memcpy(records + r * stride, &id, 4);
+        memcpy(records + r * stride + 4, "xy", 2);
+        memcpy(records + r * stride + 6, &value, 8);
+    }
+
+    uint64_t buffer_size = skip_get_record_array_size(config, count);
+    char* buffer = new char[buffer_size];
+    assert(skip_init_record_array(config, buffer, buffer_size, count) == SKIP_SUCCESS);
+    assert(skip_write_records(config, buffer, buffer_size, records, 0, 1000) == SKIP_SUCCESS);
+    assert(skip_write_records(config, buffer, buffer_size, records + 1000 * stride, 1000, count - 1000) == SKIP_SUCCESS);
+
+    // Columns sit back to back: count uint32, then count char[2], then count float64.
+    unsigned char* ids = (unsigned char*)skip_get_column_ptr(config, buffer, buffer_size, 0);
+    char* tags = (char*)skip_get_column_ptr(config, buffer, buffer_size, 1);
+    assert(ids == (unsigned char*)buffer + 8);
+    assert(tags == buffer + 8 + count * 4);
+    assert(ids[0] == 0 && ids[4 + 3] == (uint8_t)2654435761u);
+    assert(tags[2 * 777] == 'x' && tags[2 * 777 + 1] == 'y');
+    assert(skip_get_record_ptr(config, buffer, buffer_size, 0) == nullptr);
+
+    char* decoded = new char[stride * count];
+    assert(skip_read_records(config, buffer, buffer_size, decoded, 0, count) == SKIP_SUCCESS);
+    assert(memcmp(decoded, records, stride * count) == 0);
+
+    double values[100];
+    assert(skip_read_record_column(config, buffer, buffer_size, 2, 1400, 100, values) == SKIP_SUCCESS);
+    for (uint64_t r = 0; r < 100; ++r) {
+        assert(values[r] == (1400 + r) * -0.5);
+    }
+    std::cout << "Columnar records round trip and columns read directly." << std::endl;
+
+    // The layout travels in the exported header.
+    uint64_t header_size = skip_get_header_export_size();
+    char* header_buffer = new char[header_size];
+    assert(skip_export_header(config, header_buffer, header_size, NULL) == SKIP_SUCCESS);
+    void* imported = skip_import_header(header_buffer, header_size, NULL, NULL);
+    assert(imported != NULL);
+    assert(skip_get_record_layout_cfg(imported) == SKIP_LAYOUT_COLUMNS);
+
+    // Unknown layout or endian bytes are rejected rather than defaulted.
+    header_buffer[25] = 7;
+    assert(skip_import_header(header_buffer, header_size, NULL, NULL) == NULL);
+    header_buffer[25] = SKIP_LAYOUT_COLUMNS;
+    header_buffer[16] = 9;
+    assert(skip_import_header(header_buffer, header_size, NULL, NULL) == NULL);
+    std::cout << "Header export preserves the layout." << std::endl;
+
+    skip_free_cfg(imported);
+    skip_free_cfg(config);
+    delete[] header_buffer;
+    delete[] records;
+    delete[] decoded;
+    delete[] buffer;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_mmap_reader() {
+    std::cout << "--- Testing Memory-Mapped Reader ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_char, 6);
+    skip_push_type_to_config(config, skip_int64, 1000);
+
+    uint64_t data_size = skip_get_data_size(config);
+    char* data = new char[data_size];
+    int64_t values[1000];
+    for (int i = 0; i < 1000; ++i) values[i] = (int64_t)i * -123456789;
+    assert(skip_write_index_to_buffer(config, data, data_size, (void*)"mmap!", 0) == SKIP_SUCCESS);
+    assert(skip_write_index_to_buffer(config, data, data_size, values, 1) == SKIP_SUCCESS);
+
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    char* standalone = new char[standalone_size];
+    assert(skip_export_standalone(config, data, data_size, standalone, standalone_size) == SKIP_SUCCESS);
+
+    const char* path = "skip_mmap_test.skip";
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite(standalone, 1, standalone_size, file) == standalone_size);
+    fclose(file);
+
+    void* mapped = skip_mmap_open(path, SKIP_ACCESS_SEQUENTIAL);
+    assert(mapped != NULL);
+    assert(skip_mmap_advise(mapped, SKIP_ACCESS_RANDOM) == SKIP_SUCCESS);
+
+    void* mapped_cfg = skip_mmap_get_cfg(mapped);
+    assert(skip_get_cfg_endian(mapped_cfg) == SKIP_BIG_ENDIAN);
+    assert(skip_get_data_size(mapped_cfg) == data_size);
+
+    uint64_t mapped_data_size = 0;
+    char* mapped_data = (char*)skip_mmap_get_data_ptr(mapped, &mapped_data_size);
+    assert(mapped_data_size == data_size);
+    assert(memcmp(mapped_data, data, data_size) == 0);
+
+    assert(strcmp((char*)skip_mmap_get_index_ptr(mapped, 0), "mmap!") == 0);
+    int64_t values_res[1000];
+    assert(skip_read_index_from_buffer(mapped_cfg, mapped_data, mapped_data_size, values_res, 1) == SKIP_SUCCESS);
+    assert(memcmp(values, values_res, sizeof(values)) == 0);
+    assert(skip_mmap_get_index_ptr(mapped, 2) == NULL);
+    std::cout << "Fields read directly from the mapping." << std::endl;
+    skip_mmap_close(mapped);
+
+    // A truncated file must be rejected.
+    file = fopen(path, "wb");
+    fwrite(standalone, 1, standalone_size - 1, file);
+    fclose(file);
+    assert(skip_mmap_open(path, SKIP_ACCESS_NORMAL) == NULL);
+    assert(skip_mmap_open("does_not_exist.skip", SKIP_ACCESS_NORMAL) == NULL);
+    std::cout << "Truncated and missing files are rejected." << std::endl;
+    remove(path);
+
+    skip_free_cfg(config);
+    delete[] data;
+    delete[] standalone;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+static int vector_sink(void* user, const void* data, uint64_t size) {
+    std::vector<char>* out = (std::vector<char>*)user;
+    out->insert(out->end(), (const char*)data, (const char*)data + size);
+    return SKIP_SUCCESS;
+}
+
+struct StreamedFields {
+    std::vector<std::vector<char>> fields;
+    uint64_t pieces = 0;
+};
+
+static int collect_field(void* user, uint64_t index, uint64_t byte_offset, const void* data, uint64_t size) {
+    StreamedFields* out = (StreamedFields*)user;
+    if (out->fields.size() <= index) out->fields.resize(index + 1);
+    assert(out->fields[index].size() == byte_offset);
+    out->fields[index].insert(out->fields[index].end(), (const char*)data, (const char*)data + size);
+    out->pieces++;
+    return SKIP_SUCCESS;
+}
+
+void test_streaming() {
+    std::cout << "--- Testing Streaming Writer/Reader ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_char, 5);
+    skip_push_type_to_config(config, skip_int32, 1000);
+    skip_push_type_to_config(config, skip_uint8, 0);
+    skip_push_type_to_config(config, skip_float64, 3);
+
+    char text[5] = {'a', 'b', 'c', 'd', '\0'};
+    int32_t ints[1000];
+    for (int i = 0; i < 1000; ++i) ints[i] = i * 1000003;
+    double doubles[3] = {1.0, -2.5, 1e-9};
+
+    std::vector<char> streamed;
+    void* writer = skip_create_stream_writer(config, vector_sink, &streamed, 64);
+    assert(writer != NULL);
+    assert(skip_stream_write_field(writer, 1, ints) == SKIP_ERROR_OUT_OF_BOUNDS);
+    assert(skip_stream_write_field(writer, 0, text) == SKIP_SUCCESS);
+    assert(skip_stream_write_elements(writer, ints, 600) == SKIP_SUCCESS);
+    assert(skip_finish_stream_writer(writer) == SKIP_ERROR_INVALID_CONFIG);
+    assert(skip_stream_write_elements(writer, ints + 600, 400) == SKIP_SUCCESS);
+    assert(skip_stream_write_field(writer, 2, NULL) == SKIP_SUCCESS);
+    assert(skip_stream_write_field(writer, 3, doubles) == SKIP_SUCCESS);
+    assert(skip_finish_stream_writer(writer) == SKIP_SUCCESS);
+    skip_free_stream_writer(writer);
+
+    // The stream must be byte-identical to the in-memory standalone export.
+    uint64_t data_size = skip_get_data_size(config);
+    char* data = new char[data_size];
+    skip_write_index_to_buffer(config, data, data_size, text, 0);
+    skip_write_index_to_buffer(config, data, data_size, ints, 1);
+    skip_write_index_to_buffer(config, data, data_size, doubles, 3);
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    char* standalone = new char[standalone_size];
+    assert(skip_export_standalone(config, data, data_size, standalone, standalone_size) == SKIP_SUCCESS);
+    assert(streamed.size() == standalone_size);
+    assert(memcmp(streamed.data(), standalone, standalone_size) == 0);
+    std::cout << "Streamed output matches skip_export_standalone." << std::endl;
+
+    // Feed the reader in odd-sized slices.
+    StreamedFields fields;
+    void* reader = skip_create_stream_reader(collect_field, &fields, 256);
+    assert(reader != NULL);
+    assert(skip_stream_reader_get_cfg(reader) == NULL);
+    for (uint64_t pos = 0; pos < streamed.size(); pos += 7) {
+        uint64_t n = streamed.size() - pos < 7 ? streamed.size() - pos : 7;
+        assert(skip_stream_reader_feed(reader, streamed.data() + pos, n) == SKIP_SUCCESS);
+    }
+    assert(skip_stream_reader_is_done(reader));
+    assert(skip_get_data_size(skip_stream_reader_get_cfg(reader)) == data_size);
+    assert(fields.pieces > 3);
+    assert(fields.fields.size() == 4);
+    assert(memcmp(fields.fields[0].data(), text, sizeof(text)) == 0);
+    assert(fields.fields[1].size() == sizeof(ints));
+    assert(memcmp(fields.fields[1].data(), ints, sizeof(ints)) == 0);
+    assert(fields.fields[2].empty());
+    assert(memcmp(fields.fields[3].data(), doubles, sizeof(doubles)) == 0);
+    assert(skip_stream_reader_feed(reader, "x", 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+    assert(skip_set_stream_reader_max_table_size(reader, 1) == SKIP_ERROR_INVALID_ARGUMENT);
+    skip_free_stream_reader(reader);
+    std::cout << "Reader reassembles fields from partial reads." << std::endl;
+
+    // Table sizes from the header are checked before they are allocated.
+    uint64_t header_size = skip_get_header_export_size();
+    std::vector<char> forged(streamed.begin(), streamed.begin() + header_size);
+    for (int b = 0; b < 8; ++b) forged[8 + b] = (char)0xFF;
+    fields = StreamedFields();
+    reader = skip_create_stream_reader(collect_field, &fields, 64);
+    assert(skip_stream_reader_feed(reader, forged.data(), header_size) == SKIP_ERROR_INVALID_CONFIG);
+    // The error sticks; a valid stream fed afterwards is not parsed.
+    assert(skip_stream_reader_feed(reader, streamed.data(), streamed.size()) == SKIP_ERROR_INVALID_CONFIG);
+    assert(skip_stream_reader_get_cfg(reader) == NULL && fields.pieces == 0);
+    skip_free_stream_reader(reader);
+    reader = skip_create_stream_reader(collect_field, &fields, 64);
+    assert(skip_set_stream_reader_max_table_size(reader, 4) == SKIP_SUCCESS);
+    assert(skip_stream_reader_feed(reader, streamed.data(), header_size) == SKIP_ERROR_INVALID_CONFIG);
+    skip_free_stream_reader(reader);
+    std::cout << "Oversized tables are rejected." << std::endl;
+
+    // Streams carry no heap, so schemas with heap fields are refused at both
+    // ends instead of producing slots that point past the data.
+    void* heap_config = skip_create_base_config();
+    skip_push_type_to_config(heap_config, skip_int32, 1);
+    skip_push_type_to_config(heap_config, skip_string, 1);
+    std::vector<char> heap_streamed;
+    assert(skip_create_stream_writer(heap_config, vector_sink, &heap_streamed, 64) == NULL);
+    assert(heap_streamed.empty());
+
+    uint64_t heap_fixed = skip_get_data_size(heap_config);
+    std::vector<char> heap_data(heap_fixed + 16);
+    uint64_t heap_used = 0;
+    int32_t heap_id = 7;
+    skip_write_index_to_buffer(heap_config, heap_data.data(), heap_data.size(), &heap_id, 0);
+    skip_write_var_element(heap_config, heap_data.data(), heap_data.size(), &heap_used, 1, 0, "hello", 5);
+    uint64_t heap_standalone_size = skip_export_standalone_size(heap_config) + heap_used;
+    std::vector<char> heap_standalone(heap_standalone_size);
+    assert(skip_export_standalone(heap_config, heap_data.data(), heap_fixed + heap_used, heap_standalone.data(), heap_standalone_size) == SKIP_SUCCESS);
+    fields = StreamedFields();
+    reader = skip_create_stream_reader(collect_field, &fields, 64);
+    assert(skip_stream_reader_feed(reader, heap_standalone.data(), heap_standalone_size) == SKIP_ERROR_INVALID_CONFIG);
+    assert(fields.pieces == 0);
+    skip_free_stream_reader(reader);
+    skip_free_cfg(heap_config);
+    std::cout << "Heap fields are rejected by the writer and the reader." << std::endl;
+
+    skip_free_cfg(config);
+    delete[] data;
+    delete[] standalone;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_nest_and_standalone_export() {
+    std::cout << "--- Testing Nest Buffers and Standalone Export ---" << std::endl;
+
+    void* child = skip_create_base_config();
+    skip_set_endian_value_cfg(child, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(child, skip_int16, 2);
+    skip_push_type_to_config(child, skip_char, 4);
+
+    uint64_t child_size = skip_get_data_size(child);
+    char* child_data = new char[child_size];
+    int16_t shorts[2] = {-3, 300};
+    skip_write_index_to_buffer(child, child_data, child_size, shorts, 0);
+    skip_write_index_to_buffer(child, child_data, child_size, (void*)"abc", 1);
+
+    uint64_t nest_size = sizeof(uint64_t) + skip_get_export_header_body_size(child) + child_size;
+    char* nest = new char[nest_size];
+    assert(skip_create_nest_buffer(child, nest, nest_size - 1, child_data, child_size) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_create_nest_buffer(child, nest, nest_size, child_data, child_size) == SKIP_SUCCESS);
+
+    void* parent = skip_create_base_config();
+    skip_set_endian_value_cfg(parent, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(parent, skip_nest, nest_size);
+
+    void* nested_cfg = skip_create_base_config();
+    assert(skip_get_nest_cfg(parent, nested_cfg, nest, nest_size) == SKIP_SUCCESS);
+    assert(skip_get_data_size(nested_cfg) == child_size);
+
+    char* nested_data = new char[child_size];
+    assert(skip_get_nested_data_buffer(parent, nest, nest_size, nested_data, child_size) == SKIP_SUCCESS);
+    int16_t shorts_res[2];
+    assert(skip_read_index_from_buffer(nested_cfg, nested_data, child_size, shorts_res, 0) == SKIP_SUCCESS);
+    assert(shorts_res[0] == -3 && shorts_res[1] == 300);
+    std::cout << "Nested buffer round trip is correct." << std::endl;
+
+    uint64_t standalone_size = skip_export_standalone_size(child);
+    char* standalone = new char[standalone_size];
+    assert(skip_export_standalone(child, child_data, child_size, standalone, standalone_size - 1) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_export_standalone(child, child_data, child_size, standalone, standalone_size) == SKIP_SUCCESS);
+
+    void* imported = NULL;
+    assert(skip_import_standalone_get_cfg(&imported, standalone, standalone_size) == SKIP_SUCCESS);
+    assert(skip_import_standalone_get_data_buffer(imported, standalone, standalone_size, nested_data, child_size) == SKIP_SUCCESS);
+    assert(memcmp(nested_data, child_data, child_size) == 0);
+    std::cout << "Standalone round trip is correct." << std::endl;
+
+    skip_free_cfg(imported);
+    skip_free_cfg(nested_cfg);
+    skip_free_cfg(parent);
+    skip_free_cfg(child);
+    delete[] child_data;
+    delete[] nested_data;
+    delete[] nest;
+    delete[] standalone;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+struct CountingAllocator {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t live_bytes = 0;
+};
+
+static void* counting_alloc(void* user, uint64_t size) {
+    CountingAllocator* counter = (CountingAllocator*)user;
+    counter->allocs++;
+    counter->live_bytes += size;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* user, void* ptr, uint64_t old_size, uint64_t new_size) {
+    CountingAllocator* counter = (CountingAllocator*)user;
+    if (!ptr) counter->allocs++;
+    counter->live_bytes += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void* user, void* ptr, uint64_t size) {
+    CountingAllocator* counter = (CountingAllocator*)user;
+    counter->frees++;
+    counter->live_bytes -= size;
+    free(ptr);
+}
+
+void test_allocators() {
+    std::cout << "--- Testing Allocators and Arenas ---" << std::endl;
+
+    CountingAllocator counter;
+    SkipAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    assert(skip_set_allocator(&allocator) == SKIP_SUCCESS);
+
+    void* config = skip_create_base_config();
+    for (int i = 0; i < 100; ++i) {
+        skip_push_type_to_config(config, skip_int32, 1);
+    }
+    skip_compile_config(config);
+    assert(counter.allocs > 0);
+    skip_free_cfg(config);
+    assert(counter.allocs == counter.frees);
+    assert(counter.live_bytes == 0);
+    std::cout << "Global allocator sees every allocation and free." << std::endl;
+
+    assert(skip_set_allocator(NULL) == SKIP_SUCCESS);
+    SkipAllocator incomplete = {counting_alloc, NULL, counting_free, &counter};
+    assert(skip_set_allocator(&incomplete) == SKIP_ERROR_INVALID_ARGUMENT);
+
+    // Every object keeps the allocator it was created with, so swapping the
+    // global allocator between create and free is safe in both directions.
+    void* schema = skip_create_base_config();
+    skip_push_type_to_config(schema, skip_int32, 2);
+    SkipStructMember member = {0, 0};
+    std::vector<char> sunk;
+    StreamedFields streamed;
+    for (int swap_to_counting = 0; swap_to_counting < 2; ++swap_to_counting) {
+        counter = CountingAllocator();
+        assert(skip_set_allocator(swap_to_counting ? NULL : &allocator) == SKIP_SUCCESS);
+        void* map = skip_create_struct_map(schema, &member, 1, 2 * sizeof(int32_t));
+        void* writer = skip_create_stream_writer(schema, vector_sink, &sunk, 64);
+        void* reader = skip_create_stream_reader(collect_field, &streamed, 64);
+        void* region = skip_create_arena(256);
+        void* cache = skip_create_config_cache(0);
+        void* pool = skip_create_thread_pool(2);
+        void* projection = NULL;
+        assert(skip_create_projection(&projection, schema, schema) == SKIP_SUCCESS);
+        assert(map && writer && reader && region && cache && pool);
+
+        assert(skip_set_allocator(swap_to_counting ? &allocator : NULL) == SKIP_SUCCESS);
+        skip_free_struct_map(map);
+        skip_free_stream_writer(writer);
+        skip_free_stream_reader(reader);
+        skip_free_arena(region);
+        skip_free_config_cache(cache);
+        skip_free_thread_pool(pool);
+        skip_free_projection(projection);
+        assert(counter.allocs == counter.frees);
+        assert(counter.live_bytes == 0);
+    }
+    assert(skip_set_allocator(NULL) == SKIP_SUCCESS);
+    skip_free_cfg(schema);
+    std::cout << "Objects are freed with the allocator that created them." << std::endl;
+
+    // Nested configs built in an arena are released together.
+    void* child = skip_create_base_config();
+    skip_push_type_to_config(child, skip_uint16, 3);
+    skip_push_type_to_config(child, skip_float32, 1);
+    uint64_t child_size = skip_get_data_size(child);
+    uint64_t nest_size = sizeof(uint64_t) + skip_get_export_header_body_size(child) + child_size;
+    char* nest = new char[nest_size];
+    char* child_data = new char[child_size]();
+    assert(skip_create_nest_buffer(child, nest, nest_size, child_data, child_size) == SKIP_SUCCESS);
+
+    void* parent = skip_create_base_config();
+    skip_push_type_to_config(parent, skip_nest, nest_size);
+
+    void* arena = skip_create_arena(64 * 1024);
+    assert(arena != NULL);
+    SkipAllocator arena_allocator;
+    assert(skip_get_arena_allocator(arena, &arena_allocator) == SKIP_SUCCESS);
+
+    counter = CountingAllocator();
+    assert(skip_set_allocator(&allocator) == SKIP_SUCCESS);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            void* nested = skip_create_base_config_with_allocator(&arena_allocator);
+            assert(nested != NULL);
+            assert(skip_get_nest_cfg(parent, nested, nest, nest_size) == SKIP_SUCCESS);
+            assert(skip_get_data_size(nested) == child_size);
+        }
+        assert(skip_get_arena_used(arena) > 0);
+        assert(skip_reset_arena(arena) == SKIP_SUCCESS);
+        assert(skip_get_arena_used(arena) == 0);
+    }
+    assert(counter.allocs == 0);
+    assert(skip_set_allocator(NULL) == SKIP_SUCCESS);
+    std::cout << "Arena configs never touch the global allocator." << std::endl;
+
+    // A config that outgrows its arena reports the failure.
+    void* small_arena = skip_create_arena(512);
+    SkipAllocator small_allocator;
+    skip_get_arena_allocator(small_arena, &small_allocator);
+    void* grown = skip_create_base_config_with_allocator(&small_allocator);
+    assert(grown != NULL);
+    int err = SKIP_SUCCESS;
+    for (int i = 0; i < 100 && err == SKIP_SUCCESS; ++i) {
+        err = skip_push_type_to_config(grown, skip_int8, 1);
+    }
+    assert(err == SKIP_ERROR_ALLOCATION_FAILED);
+    skip_free_arena(small_arena);
+
+    skip_free_arena(arena);
+    skip_free_cfg(parent);
+    skip_free_cfg(child);
+    delete[] nest;
+    delete[] child_data;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_config_cache() {
+    std::cout << "--- Testing Config Cache ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_push_type_to_config(config, skip_int32, 1);
+    skip_push_type_to_config(config, skip_float64, 4);
+    skip_push_type_to_config(config, skip_char, 16);
+
+    uint64_t data_size = skip_get_data_size(config);
+    char* data = new char[data_size]();
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    char* standalone = new char[standalone_size];
+    assert(skip_export_standalone(config, data, data_size, standalone, standalone_size) == SKIP_SUCCESS);
+
+    void* cache = skip_create_config_cache(0);
+    assert(cache != NULL);
+
+    void* first = NULL;
+    void* second = NULL;
+    assert(skip_config_cache_import_standalone(cache, &first, standalone, standalone_size) == SKIP_SUCCESS);
+    assert(skip_config_cache_import_standalone(cache, &second, standalone, standalone_size) == SKIP_SUCCESS);
+    assert(first == second);
+    assert(skip_is_config_shared(first));
+    assert(skip_is_config_compiled(first));
+    assert(skip_get_data_size(first) == data_size);
+
+    uint64_t hits = 0, misses = 0, entries = 0;
+    skip_config_cache_get_stats(cache, &hits, &misses, &entries);
+    assert(hits == 1 && misses == 1 && entries == 1);
+    std::cout << "Repeated schema returns the same compiled config." << std::endl;
+
+    assert(skip_push_type_to_config(first, skip_int8, 1) == SKIP_ERROR_CONFIG_IMMUTABLE);
+    assert(skip_pop_type_from_config(first) == SKIP_ERROR_CONFIG_IMMUTABLE);
+    assert(skip_set_endian_value_cfg(first, SKIP_BIG_ENDIAN) == SKIP_ERROR_CONFIG_IMMUTABLE);
+    uint64_t shared_fingerprint = skip_get_schema_fingerprint(first);
+    assert(skip_import_header_body(first, "\xFF", 1) == SKIP_ERROR_CONFIG_IMMUTABLE);
+    assert(skip_get_header_format_cfg(first) == SKIP_HEADER_FORMAT_FIXED);
+    assert(skip_get_schema_fingerprint(first) == shared_fingerprint);
+    assert(skip_compile_config(first) == SKIP_SUCCESS);
+    std::cout << "Shared configs reject modification." << std::endl;
+
+    // A different endianness is a different schema.
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    assert(skip_export_standalone(config, data, data_size, standalone, standalone_size) == SKIP_SUCCESS);
+    void* other = NULL;
+    assert(skip_config_cache_import_standalone(cache, &other, standalone, standalone_size) == SKIP_SUCCESS);
+    assert(other != first);
+    skip_config_cache_get_stats(cache, &hits, &misses, &entries);
+    assert(misses == 2 && entries == 2);
+
+    // Configs outlive the cache until their last reference is released.
+    skip_free_cfg(second);
+    assert(skip_free_config_cache(cache) == SKIP_SUCCESS);
+    assert(skip_get_data_size(first) == data_size);
+    skip_free_cfg(first);
+    skip_free_cfg(other);
+
+    void* small_cache = skip_create_config_cache(1);
+    void* cached = NULL;
+    void* uncached = NULL;
+    char* body = new char[skip_get_export_header_body_size(config)];
+    skip_export_header_body(config, body, skip_get_export_header_body_size(config));
+    assert(skip_config_cache_import_header_body(small_cache, &cached, SKIP_BIG_ENDIAN, SKIP_LAYOUT_ROWS, body, skip_get_export_header_body_size(config)) == SKIP_SUCCESS);
+    assert(skip_config_cache_import_header_body(small_cache, &uncached, SKIP_LITTLE_ENDIAN, SKIP_LAYOUT_ROWS, body, skip_get_export_header_body_size(config)) == SKIP_SUCCESS);
+    assert(skip_is_config_shared(cached));
+    assert(!skip_is_config_shared(uncached));
+    skip_free_cfg(cached);
+    skip_free_cfg(uncached);
+    skip_free_config_cache(small_cache);
+    std::cout << "A full cache hands out private configs." << std::endl;
+
+    delete[] body;
+    delete[] data;
+    delete[] standalone;
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_schema_framing() {
+    std::cout << "--- Testing Schema Fingerprint Framing ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    for (int i = 0; i < 200; ++i) {
+        skip_push_type_to_config(config, i % 2 ? skip_float32 : skip_int16, 1);
+    }
+    skip_compile_config(config);
+
+    uint64_t data_size = skip_get_data_size(config);
+    char* data = new char[data_size];
+    for (uint64_t i = 0; i < data_size; ++i) data[i] = (char)i;
+
+    uint64_t full_size = skip_export_framed_size(config, 1);
+    uint64_t short_size = skip_export_framed_size(config, 0);
+    assert(full_size == short_size + skip_get_export_header_body_size(config));
+    assert(short_size < skip_export_standalone_size(config));
+    char* full = new char[full_size];
+    char* brief = new char[short_size];
+    assert(skip_export_framed(config, data, data_size, full, full_size, 1) == SKIP_SUCCESS);
+    assert(skip_export_framed(config, data, data_size, brief, short_size, 0) == SKIP_SUCCESS);
+
+    uint64_t fingerprint = 0;
+    assert(skip_get_framed_fingerprint(brief, short_size, &fingerprint) == SKIP_SUCCESS);
+    assert(fingerprint == skip_get_schema_fingerprint(config));
+
+    // Plain imports must not misread a framed message.
+    void* plain = NULL;
+    assert(skip_import_standalone_get_cfg(&plain, full, full_size) == SKIP_ERROR_INVALID_CONFIG);
+
+    void* registry = skip_create_config_cache(0);
+    void* cfg = NULL;
+    void* body = NULL;
+    assert(skip_import_framed(registry, &cfg, brief, short_size, &body) == SKIP_ERROR_UNKNOWN_SCHEMA);
+    assert(skip_import_framed(registry, &cfg, full, full_size, &body) == SKIP_SUCCESS);
+    assert(memcmp(body, data, data_size) == 0);
+    skip_free_cfg(cfg);
+    assert(skip_import_framed(registry, &cfg, brief, short_size, &body) == SKIP_SUCCESS);
+    assert(skip_get_data_size(cfg) == data_size);
+    assert(memcmp(body, data, data_size) == 0);
+    skip_free_cfg(cfg);
+    std::cout << "Fingerprint-only frames resolve after the first full frame." << std::endl;
+
+    // A registry saved to disk can be preloaded by another reader.
+    void* other = skip_create_base_config();
+    skip_push_type_to_config(other, skip_uint64, 3);
+    assert(skip_config_cache_register(registry, other) == SKIP_SUCCESS);
+    const char* path = "skip_test_registry.bin";
+    assert(skip_config_cache_save_file(registry, path) == SKIP_SUCCESS);
+
+    void* preloaded = skip_create_config_cache(0);
+    assert(skip_config_cache_load_file(preloaded, path) == SKIP_SUCCESS);
+    uint64_t entries = 0;
+    skip_config_cache_get_stats(preloaded, NULL, NULL, &entries);
+    assert(entries == 2);
+    assert(skip_import_framed(preloaded, &cfg, brief, short_size, &body) == SKIP_SUCCESS);
+    skip_free_cfg(cfg);
+    assert(skip_config_cache_find(preloaded, skip_get_schema_fingerprint(other), &cfg) == SKIP_SUCCESS);
+    assert(skip_get_data_size(cfg) == 24);
+    skip_free_cfg(cfg);
+    std::remove(path);
+    std::cout << "Registry file preloads known schemas." << std::endl;
+
+    // Fingerprints depend on the byte order.
+    skip_set_endian_value_cfg(other, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    assert(skip_config_cache_find(preloaded, skip_get_schema_fingerprint(other), &cfg) == SKIP_ERROR_UNKNOWN_SCHEMA);
+
+    skip_free_config_cache(preloaded);
+    skip_free_config_cache(registry);
+    skip_free_cfg(other);
+    skip_free_cfg(config);
+    delete[] data;
+    delete[] full;
+    delete[] brief;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_compact_header_body() {
+    std::cout << "--- Testing Compact Header Body ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    for (int i = 0; i < 40; ++i) {
+        skip_push_type_to_config(config, skip_uint8, 1);
+    }
+    skip_push_type_to_config(config, skip_float64, 300);
+    for (int i = 0; i < 30; ++i) {
+        skip_push_type_to_config(config, i % 3 == 0 ? skip_int32 : skip_int16, 1 + i % 2);
+    }
+    skip_push_type_to_config(config, skip_char, 100000);
+
+    uint64_t fixed_size = skip_get_export_header_body_size(config);
+    assert(skip_set_header_format_cfg(config, 7) == SKIP_ERROR_INVALID_ARGUMENT);
+    assert(skip_set_header_format_cfg(config, SKIP_HEADER_FORMAT_COMPACT) == SKIP_SUCCESS);
+    uint64_t compact_size = skip_get_export_header_body_size(config);
+    assert(compact_size * 4 < fixed_size);
+
+    std::vector<char> body(compact_size);
+    assert(skip_export_header_body(config, body.data(), compact_size) == SKIP_SUCCESS);
+    void* imported = skip_create_base_config();
+    assert(skip_import_header_body(imported, body.data(), compact_size) == SKIP_SUCCESS);
+    assert(skip_get_header_format_cfg(imported) == SKIP_HEADER_FORMAT_COMPACT);
+    assert(skip_get_data_size(imported) == skip_get_data_size(config));
+    for (uint64_t i = 0; i < 72; ++i) {
+        assert(skip_get_index_ptr(imported, NULL, i) == skip_get_index_ptr(config, NULL, i));
+    }
+    skip_free_cfg(imported);
+    std::cout << "Compact table round trips at " << compact_size << " of " << fixed_size << " bytes." << std::endl;
+
+    // Truncated varints are rejected.
+    imported = skip_create_base_config();
+    assert(skip_import_header_body(imported, body.data(), compact_size - 1) == SKIP_ERROR_INVALID_CONFIG);
+    skip_free_cfg(imported);
+
+    // A run of about 2^62 int32 fields is rejected before allocating, and
+    // so are runs that together pass the field limit.
+    const unsigned char huge_run[] = {0xFF, 0x05, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40};
+    const unsigned char two_runs[] = {0xFF, 0x05, 0x01, 0x80, 0x80, 0x40, 0x05, 0x01, 0x01};
+    imported = skip_create_base_config();
+    assert(skip_import_header_body(imported, (const char*)huge_run, sizeof(huge_run)) == SKIP_ERROR_INVALID_CONFIG);
+    assert(skip_import_header_body(imported, (const char*)two_runs, sizeof(two_runs)) == SKIP_ERROR_INVALID_CONFIG);
+    assert(skip_get_header_format_cfg(imported) == SKIP_HEADER_FORMAT_FIXED);
+    skip_free_cfg(imported);
+
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> data(data_size, 5);
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    std::vector<char> standalone(standalone_size);
+    assert(skip_export_standalone(config, data.data(), data_size, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    void* from_standalone = NULL;
+    assert(skip_import_standalone_get_cfg(&from_standalone, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(skip_get_header_format_cfg(from_standalone) == SKIP_HEADER_FORMAT_COMPACT);
+    std::vector<char> data_out(data_size);
+    assert(skip_import_standalone_get_data_buffer(from_standalone, standalone.data(), standalone_size, data_out.data(), data_size) == SKIP_SUCCESS);
+    assert(data_out == data);
+    skip_free_cfg(from_standalone);
+
+    // The streaming writer emits the same bytes as the standalone export.
+    std::vector<char> streamed;
+    void* writer = skip_create_stream_writer(config, vector_sink, &streamed, 64);
+    for (uint64_t i = 0; i < 72; ++i) {
+        assert(skip_stream_write_field(writer, i, skip_get_index_ptr(config, data.data(), i)) == SKIP_SUCCESS);
+    }
+    assert(skip_finish_stream_writer(writer) == SKIP_SUCCESS);
+    skip_free_stream_writer(writer);
+    assert(streamed == standalone);
+    std::cout << "Standalone and streamed exports use the compact table." << std::endl;
+
+    // Nested payloads shrink the same way.
+    uint64_t nest_size = sizeof(uint64_t) + compact_size + data_size;
+    std::vector<char> nest(nest_size);
+    assert(skip_create_nest_buffer(config, nest.data(), nest_size, data.data(), data_size) == SKIP_SUCCESS);
+    void* parent = skip_create_base_config();
+    skip_push_type_to_config(parent, skip_nest, nest_size);
+    void* nested = skip_create_base_config();
+    assert(skip_get_nest_cfg(parent, nested, nest.data(), nest_size) == SKIP_SUCCESS);
+    assert(skip_get_data_size(nested) == data_size);
+    assert(skip_get_nested_data_buffer(nested, nest.data(), nest_size, data_out.data(), data_size) == SKIP_SUCCESS);
+    assert(data_out == data);
+    skip_free_cfg(nested);
+    skip_free_cfg(parent);
+    std::cout << "Nested compact tables are detected on import." << std::endl;
+
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+static int32_t walk_nested_views(SkipView* view, int depth) {
+    int32_t value = 0;
+    assert(skip_view_read_index(view, 0, &value) == SKIP_SUCCESS);
+    if (depth > 1) {
+        SkipView child;
+        assert(skip_view_get_child(view, 1, &child) == SKIP_SUCCESS);
+        value += walk_nested_views(&child, depth - 1);
+        skip_view_release(&child);
+    }
+    return value;
+}
+
+void test_nested_views() {
+    std::cout << "--- Testing Nested Views ---" << std::endl;
+
+    // Build a five level tree bottom up: each level holds an int32 and,
+    // except the innermost one, the nested blob of the next level.
+    std::vector<char> blob;
+    std::vector<void*> configs;
+    for (int level = 5; level >= 1; --level) {
+        void* config = skip_create_base_config();
+        skip_push_type_to_config(config, skip_int32, 1);
+        if (!blob.empty()) {
+            skip_push_type_to_config(config, skip_nest, blob.size());
+        }
+        std::vector<char> data(skip_get_data_size(config));
+        int32_t value = level;
+        skip_write_index_to_buffer(config, data.data(), data.size(), &value, 0);
+        if (!blob.empty()) {
+            skip_write_index_to_buffer(config, data.data(), data.size(), blob.data(), 1);
+        }
+
+        if (level == 1) {
+            blob = data;
+        } else {
+            std::vector<char> nest(sizeof(uint64_t) + skip_get_export_header_body_size(config) + data.size());
+            assert(skip_create_nest_buffer(config, nest.data(), nest.size(), data.data(), data.size()) == SKIP_SUCCESS);
+            blob = nest;
+        }
+        configs.push_back(config);
+    }
+    void* root_cfg = configs.back();
+
+    void* cache = skip_create_config_cache(0);
+    SkipView root;
+    assert(skip_view_init(&root, cache, root_cfg, blob.data(), blob.size()) == SKIP_SUCCESS);
+    assert(walk_nested_views(&root, 5) == 15);
+
+    // Every schema has been seen once, so the next walk allocates nothing.
+    CountingAllocator counter;
+    SkipAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    skip_set_allocator(&allocator);
+    for (int i = 0; i < 100; ++i) {
+        assert(walk_nested_views(&root, 5) == 15);
+    }
+    skip_set_allocator(NULL);
+    assert(counter.allocs == 0);
+    std::cout << "Repeated walks are allocation free." << std::endl;
+
+    // Child data points into the parent buffer.
+    SkipView child;
+    assert(skip_view_get_child(&root, 1, &child) == SKIP_SUCCESS);
+    uint64_t size = 0;
+    char* field = (char*)skip_view_get_index_ptr(&child, 0, &size);
+    assert(size == sizeof(int32_t));
+    assert(field > blob.data() && field < blob.data() + blob.size());
+    assert(skip_view_get_child(&child, 0, &child) == SKIP_ERROR_INVALID_ARGUMENT);
+    skip_view_release(&child);
+
+    // Without a cache each child owns a private config.
+    SkipView uncached;
+    skip_view_init(&uncached, NULL, root_cfg, blob.data(), blob.size());
+    assert(walk_nested_views(&uncached, 5) == 15);
+    std::cout << "Child views point into the parent buffer." << std::endl;
+
+    skip_view_release(&root);
+    skip_free_config_cache(cache);
+    for (void* config : configs) {
+        skip_free_cfg(config);
+    }
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_var_length_fields() {
+    std::cout << "--- Testing Variable-Length Fields ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_int32, 1);
+    skip_push_type_to_config(config, skip_string, 3);
+    skip_push_type_to_config(config, skip_bytes, 1);
+    skip_push_type_to_config(config, skip_float64, 1);
+    assert(skip_get_data_size(config) == 4 + 3 * 16 + 16 + 8);
+    skip_compile_config(config);
+
+    // One fixed schema carries payloads of any length.
+    const char* words[2][3] = {{"alpha", "", "gamma ray"}, {"a much longer string than before", "b", "c"}};
+    for (int message = 0; message < 2; ++message) {
+        std::vector<char> buffer(skip_get_data_size(config) + 128);
+        uint64_t heap_used = 0;
+        int32_t id = 7 + message;
+        double ratio = 0.5 * message;
+        skip_write_index_to_buffer(config, buffer.data(), buffer.size(), &id, 0);
+        skip_write_index_to_buffer(config, buffer.data(), buffer.size(), &ratio, 3);
+        for (uint64_t i = 0; i < 3; ++i) {
+            assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 1, i, words[message][i], strlen(words[message][i])) == SKIP_SUCCESS);
+        }
+        const unsigned char blob[4] = {0, 1, 2, 255};
+        assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 2, 0, blob, sizeof(blob)) == SKIP_SUCCESS);
+        uint64_t message_size = skip_get_data_size(config) + heap_used;
+
+        SkipIoVec view;
+        for (uint64_t i = 0; i < 3; ++i) {
+            assert(skip_read_var_element(config, buffer.data(), message_size, 1, i, &view) == SKIP_SUCCESS);
+            assert(view.len == strlen(words[message][i]));
+            assert(strcmp((const char*)view.base, words[message][i]) == 0);
+            assert((char*)view.base >= buffer.data() && (char*)view.base < buffer.data() + message_size);
+        }
+        assert(skip_read_var_element(config, buffer.data(), message_size, 2, 0, &view) == SKIP_SUCCESS);
+        assert(view.len == sizeof(blob) && memcmp(view.base, blob, sizeof(blob)) == 0);
+
+        int32_t id_out = 0;
+        double ratio_out = -1;
+        skip_read_index_from_buffer(config, buffer.data(), message_size, &id_out, 0);
+        skip_read_index_from_buffer(config, buffer.data(), message_size, &ratio_out, 3);
+        assert(id_out == id && ratio_out == ratio);
+
+        // The heap travels with standalone exports.
+        uint64_t standalone_size = skip_export_standalone_size(config) + heap_used;
+        std::vector<char> standalone(standalone_size);
+        assert(skip_export_standalone(config, buffer.data(), message_size, standalone.data(), standalone_size) == SKIP_SUCCESS);
+        void* imported = NULL;
+        uint64_t data_size = 0;
+        void* header_cfg = skip_import_header(standalone.data(), standalone_size, NULL, &data_size);
+        assert(data_size == message_size);
+        skip_free_cfg(header_cfg);
+        assert(skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size) == SKIP_SUCCESS);
+        std::vector<char> data(data_size);
+        assert(skip_import_standalone_get_data_buffer(imported, standalone.data(), standalone_size, data.data(), data_size) == SKIP_SUCCESS);
+        assert(skip_read_var_element(imported, data.data(), data_size, 1, 2, &view) == SKIP_SUCCESS);
+        assert(strcmp((const char*)view.base, words[message][2]) == 0);
+        skip_free_cfg(imported);
+    }
+    std::cout << "Strings and bytes round trip without changing the config." << std::endl;
+
+    std::vector<char> small(skip_get_data_size(config) + 4);
+    uint64_t heap_used = 0;
+    assert(skip_write_var_element(config, small.data(), small.size(), &heap_used, 1, 0, "abcd", 4) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_write_var_element(config, small.data(), small.size(), &heap_used, 1, 3, "a", 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+    assert(skip_write_var_element(config, small.data(), small.size(), &heap_used, 0, 0, "a", 1) == SKIP_ERROR_INVALID_ARGUMENT);
+    assert(skip_write_var_element(config, small.data(), small.size(), &heap_used, 2, 0, "abcd", 4) == SKIP_SUCCESS);
+    SkipIoVec view;
+    assert(skip_read_var_element(config, small.data(), small.size() - 1, 2, 0, &view) == SKIP_ERROR_OUT_OF_BOUNDS);
+    std::cout << "Heap bounds are checked." << std::endl;
+
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_dynamic_arrays() {
+    std::cout << "--- Testing Dynamic-Count Arrays ---" << std::endl;
+
+    // Built once and reused for messages of any length.
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_uint32, 1);
+    skip_push_type_to_config(config, skip_array | skip_int32, 1);
+    skip_push_type_to_config(config, skip_array | skip_float64, 2);
+    skip_push_type_to_config(config, skip_string, 1);
+    skip_compile_config(config);
+    uint64_t fixed_size = skip_get_data_size(config);
+    assert(fixed_size == 4 + 16 + 32 + 16);
+
+    for (uint64_t n = 1000; n <= 1001; ++n) {
+        std::vector<int32_t> ints(n);
+        std::vector<double> first(n / 10), second;
+        for (uint64_t i = 0; i < n; ++i) ints[i] = (int32_t)(i * 7 - 300);
+        for (uint64_t i = 0; i < first.size(); ++i) first[i] = i * 0.25;
+
+        std::vector<char> buffer(fixed_size + n * 4 + first.size() * 8 + 16);
+        uint64_t heap_used = 0;
+        uint32_t id = (uint32_t)n;
+        skip_write_index_to_buffer(config, buffer.data(), buffer.size(), &id, 0);
+        assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 1, 0, ints.data(), n) == SKIP_SUCCESS);
+        assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 2, 0, first.data(), first.size()) == SKIP_SUCCESS);
+        assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 2, 1, second.data(), 0) == SKIP_SUCCESS);
+        assert(skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 3, 0, "tag", 3) == SKIP_SUCCESS);
+        uint64_t message_size = fixed_size + heap_used;
+
+        std::vector<int32_t> ints_out(n);
+        uint64_t count = 0;
+        assert(skip_read_array_element(config, buffer.data(), message_size, 1, 0, ints_out.data(), n, &count) == SKIP_SUCCESS);
+        assert(count == n && ints_out == ints);
+
+        std::vector<double> first_out(first.size());
+        assert(skip_read_array_element(config, buffer.data(), message_size, 2, 0, first_out.data(), first_out.size(), &count) == SKIP_SUCCESS);
+        assert(first_out == first);
+        assert(skip_read_array_element(config, buffer.data(), message_size, 2, 1, NULL, 0, &count) == SKIP_SUCCESS);
+        assert(count == 0);
+
+        // Elements are stored in the config's byte order.
+        SkipIoVec raw;
+        assert(skip_read_var_element(config, buffer.data(), message_size, 1, 0, &raw) == SKIP_SUCCESS);
+        assert(raw.len == n * sizeof(int32_t));
+        int32_t stored;
+        memcpy(&stored, (char*)raw.base + 4, sizeof(stored));
+        assert(swap_u32_for_test((uint32_t)stored) == (uint32_t)ints[1]);
+
+        assert(skip_read_array_element(config, buffer.data(), message_size, 1, 0, ints_out.data(), n - 1, &count) == SKIP_ERROR_BUFFER_TOO_SMALL);
+        assert(count == n);
+    }
+    std::cout << "One config encodes arrays of any length." << std::endl;
+
+    void* invalid = skip_create_base_config();
+    skip_push_type_to_config(invalid, skip_array | skip_string, 1);
+    assert(skip_get_data_size(invalid) == 0);
+    char dummy[16] = {0};
+    uint64_t heap_used = 0;
+    assert(skip_write_var_element(invalid, dummy, sizeof(dummy), &heap_used, 0, 0, "x", 1) == SKIP_ERROR_INVALID_ARGUMENT);
+    skip_free_cfg(invalid);
+    std::cout << "Arrays of variable-length types are rejected." << std::endl;
+
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+// Fails every allocation after the first fail_after. Counters are atomic
+// because pool workers free their start arguments on their own threads.
+struct FailingAllocator {
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<int64_t> live_bytes{0};
+    uint64_t fail_after = 0;
+};
+
+static void* failing_alloc(void* user, uint64_t size) {
+    FailingAllocator* counter = (FailingAllocator*)user;
+    if (counter->allocs++ >= counter->fail_after) return NULL;
+    counter->live_bytes += (int64_t)size;
+    return malloc(size);
+}
+
+static void* failing_realloc(void* user, void* ptr, uint64_t old_size, uint64_t new_size) {
+    FailingAllocator* counter = (FailingAllocator*)user;
+    if (counter->allocs++ >= counter->fail_after) return NULL;
+    counter->live_bytes += (int64_t)new_size - (int64_t)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void failing_free(void* user, void* ptr, uint64_t size) {
+    FailingAllocator* counter = (FailingAllocator*)user;
+    counter->live_bytes -= (int64_t)size;
+    free(ptr);
+}
+
+void test_parallel_transfer() {
+    std::cout << "--- Testing Parallel Write/Read All ---" << std::endl;
+
+    // Field sizes are chosen so chunk boundaries fall inside fields and
+    // between elements of odd-sized neighbours.
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN);
+    const uint64_t counts[] = {3, 1000003, 777, 300001, 5, 200000};
+    const int32_t types[] = {skip_uint8, skip_int32, skip_int16, skip_float64, skip_char, skip_uint64};
+    for (int i = 0; i < 6; ++i) {
+        skip_push_type_to_config(config, types[i], counts[i]);
+    }
+
+    std::vector<std::vector<char>> values(6);
+    std::vector<SkipIoVec> fields(6);
+    for (int i = 0; i < 6; ++i) {
+        values[i].resize(counts[i] * skip_get_datatype_size(types[i]));
+        for (uint64_t b = 0; b < values[i].size(); ++b) values[i][b] = (char)(b * 31 + i);
+        fields[i] = {values[i].data(), values[i].size()};
+    }
+
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> expected(data_size), actual(data_size);
+    assert(skip_write_all(config, expected.data(), data_size, fields.data(), 6) == SKIP_SUCCESS);
+
+    void* pool = skip_create_thread_pool(4);
+    assert(pool != NULL);
+    assert(skip_get_thread_pool_size(pool) == 4);
+    for (int compiled = 0; compiled < 2; ++compiled) {
+        if (compiled) skip_compile_config(config);
+        std::fill(actual.begin(), actual.end(), 0);
+        assert(skip_write_all_parallel(pool, config, actual.data(), data_size, fields.data(), 6) == SKIP_SUCCESS);
+        assert(actual == expected);
+
+        std::vector<std::vector<char>> decoded(6);
+        std::vector<SkipIoVec> out(6);
+        for (int i = 0; i < 6; ++i) {
+            decoded[i].resize(values[i].size());
+            out[i] = {decoded[i].data(), decoded[i].size()};
+        }
+        assert(skip_read_all_parallel(pool, config, actual.data(), data_size, out.data(), 6) == SKIP_SUCCESS);
+        assert(decoded == values);
+    }
+    std::cout << "Parallel transfers match the serial encoding." << std::endl;
+
+    // Without a pool the call runs on the calling thread.
+    std::fill(actual.begin(), actual.end(), 0);
+    assert(skip_write_all_parallel(NULL, config, actual.data(), data_size, fields.data(), 6) == SKIP_SUCCESS);
+    assert(actual == expected);
+    assert(skip_write_all_parallel(pool, config, actual.data(), data_size - 1, fields.data(), 6) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_write_all_parallel(pool, config, actual.data(), data_size, fields.data(), 5) == SKIP_ERROR_INVALID_ARGUMENT);
+
+    skip_free_thread_pool(pool);
+
+    // A worker that cannot be started tears down the ones already running.
+    // The pool itself takes three allocations, then one per worker.
+    for (uint64_t fail_after = 0; fail_after < 7; ++fail_after) {
+        FailingAllocator failing;
+        failing.fail_after = fail_after;
+        SkipAllocator allocator = {failing_alloc, failing_realloc, failing_free, &failing};
+        skip_set_allocator(&allocator);
+        pool = skip_create_thread_pool(8);
+        skip_set_allocator(NULL);
+        assert(pool == NULL);
+        assert(failing.live_bytes == 0);
+    }
+    std::cout << "Failed pool creation joins each started worker once." << std::endl;
+
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_header_without_init() {
+    std::cout << "--- Testing Header Without Init ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    skip_push_type_to_config(config, skip_uint16, 3);
+    skip_push_type_to_config(config, skip_float64, 1);
+
+    // The header is a fixed little-endian layout regardless of the host.
+    uint64_t header_size = skip_get_header_export_size();
+    assert(header_size == 32);
+    std::vector<unsigned char> header(header_size, 0xAA);
+    uint64_t body_size = 0;
+    assert(skip_export_header(config, (char*)header.data(), header_size, &body_size) == SKIP_SUCCESS);
+    assert(skip_export_header(config, (char*)header.data(), header_size - 1, NULL) == SKIP_ERROR_BUFFER_TOO_SMALL);
+
+    const unsigned char magic[] = {0x50, 0x49, 0x4B, 0x53};
+    assert(memcmp(header.data(), magic, 4) == 0);
+    assert(header[4] == 211 && header[5] == 0 && header[6] == 0 && header[7] == 0);
+    assert(header[8] == body_size && header[15] == 0);
+    assert(header[16] == SKIP_BIG_ENDIAN);
+    assert(header[17] == skip_get_data_size(config) && header[24] == 0);
+    for (int i = 27; i < 32; ++i) assert(header[i] == 0);
+
+    // Any number of threads can export and import headers concurrently.
+    std::vector<std::thread> threads;
+    std::vector<int> ok(8, 0);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<char> local(header_size);
+            int good = 1;
+            for (int i = 0; i < 1000 && good; ++i) {
+                uint64_t local_body = 0, local_data = 0;
+                good &= skip_export_header(config, local.data(), header_size, NULL) == SKIP_SUCCESS;
+                good &= memcmp(local.data(), header.data(), header_size) == 0;
+                void* imported = skip_import_header(local.data(), header_size, &local_body, &local_data);
+                good &= imported != NULL && local_body == body_size && local_data == skip_get_data_size(config);
+                good &= imported && skip_get_cfg_endian(imported) == SKIP_BIG_ENDIAN;
+                skip_free_cfg(imported);
+            }
+            ok[t] = good;
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (int good : ok) assert(good);
+    std::cout << "Headers round-trip concurrently without skip_init." << std::endl;
+
+    header[0] ^= 0xFF;
+    assert(skip_import_header(header.data(), header_size, NULL, NULL) == NULL);
+
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_typed_schema() {
+    std::cout << "--- Testing Typed C++ Schema ---" << std::endl;
+
+    constexpr int other_endian = skip::host_endian == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN;
+    using Record = skip::BasicSchema<other_endian, skip::i32, skip::f64[4], skip::chars<16>, skip::u16>;
+    static_assert(Record::field_count == 4, "field count");
+    static_assert(Record::offset<0> == 0 && Record::offset<1> == 4 && Record::offset<2> == 36 && Record::offset<3> == 52, "offsets");
+    static_assert(Record::size == 54, "size");
+    static_assert(Record::count<1> == 4 && Record::type_code<2> == skip_char, "field traits");
+    static_assert(skip::Schema<skip::u8>::endian == skip::host_endian, "default endian");
+
+    void* config = Record::create_config();
+    assert(config != NULL);
+    assert(Record::matches(config));
+    assert(skip_get_data_size(config) == Record::size);
+
+    // Typed writes decode through the runtime config.
+    std::vector<char> buffer(Record::size);
+    const double samples[4] = {1.5, -2.25, 1e300, 0.0};
+    const char name[16] = "typed-schema";
+    Record::set<0>(buffer.data(), -123456);
+    Record::write<1>(buffer.data(), samples);
+    Record::write<2>(buffer.data(), name);
+    Record::set<3>(buffer.data(), 0xBEEF);
+
+    int32_t id = 0;
+    double decoded[4];
+    char decoded_name[16];
+    uint16_t tag = 0;
+    assert(skip_read_index_from_buffer(config, buffer.data(), buffer.size(), &id, 0) == SKIP_SUCCESS);
+    assert(skip_read_index_from_buffer(config, buffer.data(), buffer.size(), decoded, 1) == SKIP_SUCCESS);
+    assert(skip_read_index_from_buffer(config, buffer.data(), buffer.size(), decoded_name, 2) == SKIP_SUCCESS);
+    assert(skip_read_index_from_buffer(config, buffer.data(), buffer.size(), &tag, 3) == SKIP_SUCCESS);
+    assert(id == -123456 && tag == 0xBEEF);
+    assert(memcmp(decoded, samples, sizeof(samples)) == 0);
+    assert(memcmp(decoded_name, name, sizeof(name)) == 0);
+
+    // Runtime writes decode through the typed accessors.
+    double updated[4] = {42.0, -2.25, 1e300, 0.0};
+    assert(skip_write_index_to_buffer(config, buffer.data(), buffer.size(), updated, 1) == SKIP_SUCCESS);
+    assert(Record::get<1>(buffer.data(), 0) == 42.0);
+    assert(Record::get<1>(buffer.data(), 2) == 1e300);
+    Record::set<1>(buffer.data(), 3, -7.0);
+    assert(Record::get<1>(buffer.data(), 3) == -7.0);
+    std::cout << "Typed and runtime accessors agree on the encoding." << std::endl;
+
+    // The generated config exports like any runtime config.
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    std::vector<char> standalone(standalone_size);
+    assert(skip_export_standalone(config, buffer.data(), buffer.size(), standalone.data(), standalone_size) == SKIP_SUCCESS);
+    void* imported = NULL;
+    assert(skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(Record::matches(imported));
+    std::vector<char> round_trip(Record::size);
+    assert(skip_import_standalone_get_data_buffer(imported, standalone.data(), standalone_size, round_trip.data(), round_trip.size()) == SKIP_SUCCESS);
+    assert(round_trip == buffer);
+    assert(Record::get<0>(round_trip.data()) == -123456);
+
+    using Prefix = skip::BasicSchema<other_endian, skip::i32, skip::f64[4]>;
+    using HostOrder = skip::Schema<skip::i32, skip::f64[4], skip::chars<16>, skip::u16>;
+    assert(!Prefix::matches(imported));
+    assert(!HostOrder::matches(imported));
+    skip_free_cfg(imported);
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_field_names() {
+    std::cout << "--- Testing Field Names ---" << std::endl;
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, SKIP_BIG_ENDIAN);
+    assert(skip_push_named_type_to_config(config, "id", skip_uint64, 1) == SKIP_SUCCESS);
+    assert(skip_push_type_to_config(config, skip_char, 16) == SKIP_SUCCESS);
+    assert(skip_push_named_type_to_config(config, "price", skip_float64, 1) == SKIP_SUCCESS);
+    assert(skip_push_named_type_to_config(config, "qty", skip_int32, 4) == SKIP_SUCCESS);
+    // Duplicate names are accepted here and rejected when compiling.
+    assert(skip_push_named_type_to_config(config, "price", skip_int8, 1) == SKIP_SUCCESS);
+    assert(skip_compile_config(config) == SKIP_ERROR_INVALID_CONFIG);
+    assert(skip_pop_type_from_config(config) == SKIP_SUCCESS);
+    assert(skip_get_type_at_index(config, 4) == NULL);
+    assert(skip_set_field_name(config, 9, "late") == SKIP_ERROR_OUT_OF_BOUNDS);
+    assert(skip_set_field_name(config, 1, "symbol") == SKIP_SUCCESS);
+    assert(strcmp(skip_get_field_name(config, 1), "symbol") == 0);
+
+    // Lookups work before compiling by scanning, and after through the index.
+    for (int compiled = 0; compiled < 2; ++compiled) {
+        if (compiled) assert(skip_compile_config(config) == SKIP_SUCCESS);
+        assert(skip_field_index(config, "id") == 0);
+        assert(skip_field_index(config, "symbol") == 1);
+        assert(skip_field_index(config, "price") == 2);
+        assert(skip_field_index(config, "qty") == 3);
+        assert(skip_field_index(config, "pric") == SKIP_ERROR_UNKNOWN_FIELD);
+        assert(skip_field_index(config, "") == SKIP_ERROR_UNKNOWN_FIELD);
+        assert(skip_field_index_n(config, "price_level", 5) == 2);
+    }
+
+    // Popping a field drops its name; renaming keeps the index consistent.
+    assert(skip_pop_type_from_config(config) == SKIP_SUCCESS);
+    assert(skip_field_index(config, "qty") == SKIP_ERROR_UNKNOWN_FIELD);
+    assert(skip_push_named_type_to_config(config, "quantity", skip_int32, 4) == SKIP_SUCCESS);
+    assert(skip_set_field_name(config, 2, "bid") == SKIP_SUCCESS);
+    assert(skip_set_field_name(config, 1, NULL) == SKIP_SUCCESS);
+    assert(skip_get_field_name(config, 1) == NULL);
+    assert(skip_compile_config(config) == SKIP_SUCCESS);
+    assert(skip_field_index(config, "price") == SKIP_ERROR_UNKNOWN_FIELD);
+    assert(skip_field_index(config, "bid") == 2);
+    assert(skip_field_index(config, "quantity") == 3);
+    assert(skip_field_index(config, "symbol") == SKIP_ERROR_UNKNOWN_FIELD);
+    std::cout << "Names resolve to indexes before and after compiling." << std::endl;
+
+    // Names travel in the header body of both table formats and in the
+    // standalone and streaming encodings.
+    const int formats[] = {SKIP_HEADER_FORMAT_FIXED, SKIP_HEADER_FORMAT_COMPACT};
+    for (int format : formats) {
+        skip_set_header_format_cfg(config, format);
+        uint64_t body_size = skip_get_export_header_body_size(config);
+        std::vector<char> body(body_size);
+        assert(skip_export_header_body(config, body.data(), body_size) == SKIP_SUCCESS);
+
+        void* imported = skip_create_base_config();
+        skip_set_endian_value_cfg(imported, SKIP_BIG_ENDIAN);
+        assert(skip_import_header_body(imported, body.data(), body_size) == SKIP_SUCCESS);
+        assert(skip_get_header_format_cfg(imported) == format);
+        assert(skip_get_field_name(imported, 1) == NULL);
+        assert(strcmp(skip_get_field_name(imported, 3), "quantity") == 0);
+        assert(skip_get_data_size(imported) == skip_get_data_size(config));
+        assert(skip_compile_config(imported) == SKIP_SUCCESS);
+        assert(skip_field_index(imported, "bid") == 2);
+        skip_free_cfg(imported);
+    }
+
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> data(data_size, 3);
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    std::vector<char> standalone(standalone_size);
+    assert(skip_export_standalone(config, data.data(), data_size, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(standalone[4] == (char)213);
+    void* imported = NULL;
+    assert(skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(strcmp(skip_get_field_name(imported, 0), "id") == 0);
+    skip_free_cfg(imported);
+
+    std::vector<char> streamed;
+    void* writer = skip_create_stream_writer(config, vector_sink, &streamed, 64);
+    assert(writer != NULL);
+    for (uint64_t i = 0; i < 4; ++i) {
+        assert(skip_stream_write_field(writer, i, data.data()) == SKIP_SUCCESS);
+    }
+    assert(skip_finish_stream_writer(writer) == SKIP_SUCCESS);
+    skip_free_stream_writer(writer);
+    assert(streamed == standalone);
+
+    // Shared configs from a cache come compiled, with the index built.
+    void* cache = skip_create_config_cache(0);
+    void* shared = NULL;
+    assert(skip_config_cache_import_standalone(cache, &shared, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(skip_field_index(shared, "quantity") == 3);
+    assert(skip_set_field_name(shared, 0, "other") == SKIP_ERROR_CONFIG_IMMUTABLE);
+    skip_free_cfg(shared);
+    skip_free_config_cache(cache);
+    std::cout << "Names survive export, import, streaming and caching." << std::endl;
+
+    // A table whose names collide imports, but cannot be compiled.
+    skip_set_header_format_cfg(config, SKIP_HEADER_FORMAT_FIXED);
+    assert(skip_set_field_name(config, 0, "bie") == SKIP_SUCCESS);
+    uint64_t body_size = skip_get_export_header_body_size(config);
+    std::vector<char> body(body_size);
+    skip_export_header_body(config, body.data(), body_size);
+    std::string raw(body.data(), body_size);
+    raw[raw.find("bie") + 2] = 'd';
+    imported = skip_create_base_config();
+    skip_set_endian_value_cfg(imported, SKIP_BIG_ENDIAN);
+    assert(skip_import_header_body(imported, raw.data(), body_size) == SKIP_SUCCESS);
+    assert(skip_compile_config(imported) == SKIP_ERROR_INVALID_CONFIG);
+    skip_free_cfg(imported);
+    skip_free_cfg(config);
+
+    // Large schemas still get a collision-free index.
+    config = skip_create_base_config();
+    char name[32];
+    for (int i = 0; i < 5000; ++i) {
+        snprintf(name, sizeof(name), "field_%d", i);
+        assert(skip_push_named_type_to_config(config, name, skip_int32, 1) == SKIP_SUCCESS);
+    }
+    assert(skip_compile_config(config) == SKIP_SUCCESS);
+    for (int i = 0; i < 5000; ++i) {
+        snprintf(name, sizeof(name), "field_%d", i);
+        assert(skip_field_index(config, name) == i);
+    }
+    assert(skip_field_index(config, "field_5000") == SKIP_ERROR_UNKNOWN_FIELD);
+    skip_free_cfg(config);
+
+    // Repeated renames reuse or compact the name pool instead of growing it.
+    CountingAllocator counter;
+    SkipAllocator allocator = {counting_alloc, counting_realloc, counting_free, &counter};
+    config = skip_create_base_config_with_allocator(&allocator);
+    for (int i = 0; i < 8; ++i) {
+        snprintf(name, sizeof(name), "f%d", i);
+        skip_push_named_type_to_config(config, name, skip_int32, 1);
+    }
+    uint64_t settled = 0;
+    for (int round = 0; round < 20000; ++round) {
+        snprintf(name, sizeof(name), round % 2 ? "short_%d" : "a_much_longer_name_%d", round % 8);
+        assert(skip_set_field_name(config, round % 8, name) == SKIP_SUCCESS);
+        if (round == 1000) settled = counter.live_bytes;
+    }
+    assert(counter.live_bytes <= settled + 64);
+    assert(skip_compile_config(config) == SKIP_SUCCESS);
+    assert(strcmp(skip_get_field_name(config, 7), "short_7") == 0);
+    assert(strcmp(skip_get_field_name(config, 0), "a_much_longer_name_0") == 0);
+    assert(skip_field_index(config, "short_7") == 7);
+    skip_free_cfg(config);
+    assert(counter.live_bytes == 0);
+
+    // A compact table is hashed from scratch memory; when that cannot be
+    // allocated, compiling and framing fail instead of using fingerprint 0.
+    FailingAllocator failing;
+    failing.fail_after = UINT64_MAX;
+    SkipAllocator failing_allocator = {failing_alloc, failing_realloc, failing_free, &failing};
+    config = skip_create_base_config_with_allocator(&failing_allocator);
+    skip_set_header_format_cfg(config, SKIP_HEADER_FORMAT_COMPACT);
+    skip_push_type_to_config(config, skip_int32, 4);
+    assert(skip_compile_config(config) == SKIP_SUCCESS);
+    uint64_t fingerprint = skip_get_schema_fingerprint(config);
+    skip_set_endian_value_cfg(config, skip_get_cfg_endian(config));
+    failing.fail_after = failing.allocs;
+    assert(skip_compile_config(config) == SKIP_ERROR_ALLOCATION_FAILED);
+    assert(!skip_is_config_compiled(config));
+    uint64_t framed_size = skip_export_framed_size(config, 0);
+    std::vector<char> fields(skip_get_data_size(config));
+    std::vector<char> framed(framed_size);
+    assert(skip_export_framed(config, fields.data(), fields.size(), framed.data(), framed_size, 0) == SKIP_ERROR_ALLOCATION_FAILED);
+    failing.fail_after = UINT64_MAX;
+    assert(skip_compile_config(config) == SKIP_SUCCESS);
+    assert(skip_get_schema_fingerprint(config) == fingerprint);
+    skip_free_cfg(config);
+    assert(failing.live_bytes == 0);
+    std::cout << "Fingerprint allocation failures are reported." << std::endl;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_schema_projection() {
+    std::cout << "--- Testing Schema Projection ---" << std::endl;
+
+    int other = skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN;
+
+    // The writer is one version ahead: "flags" was added in the middle,
+    // "legacy" was removed and "qty" grew from 2 to 4 elements.
+    void* writer = skip_create_base_config();
+    skip_set_endian_value_cfg(writer, other);
+    skip_push_named_type_to_config(writer, "id", skip_uint64, 1);
+    skip_push_named_type_to_config(writer, "flags", skip_uint16, 1);
+    skip_push_named_type_to_config(writer, "price", skip_float64, 1);
+    skip_push_named_type_to_config(writer, "qty", skip_int32, 4);
+    skip_push_named_type_to_config(writer, "note", skip_string, 1);
+    skip_compile_config(writer);
+
+    void* reader = skip_create_base_config();
+    skip_push_named_type_to_config(reader, "id", skip_uint64, 1);
+    skip_push_named_type_to_config(reader, "price", skip_float64, 1);
+    skip_push_named_type_to_config(reader, "legacy", skip_int16, 3);
+    skip_push_named_type_to_config(reader, "qty", skip_int32, 2);
+    skip_push_named_type_to_config(reader, "note", skip_string, 1);
+    skip_push_named_type_to_config(reader, "extra", skip_int32, 2);
+
+    void* projection = NULL;
+    assert(skip_create_projection(&projection, writer, reader) == SKIP_SUCCESS);
+    assert(skip_get_projection_source(projection, 0) == 0);
+    assert(skip_get_projection_source(projection, 1) == 2);
+    assert(skip_get_projection_source(projection, 2) == SKIP_ERROR_UNKNOWN_FIELD);
+    assert(skip_get_projection_source(projection, 3) == 3);
+    assert(skip_get_projection_source(projection, 6) == SKIP_ERROR_OUT_OF_BOUNDS);
+    int16_t legacy_default = -2;
+    assert(skip_set_projection_default(projection, 2, &legacy_default) == SKIP_SUCCESS);
+    assert(skip_set_projection_default(projection, 0, &legacy_default) == SKIP_SUCCESS);
+
+    uint64_t id = 0x0102030405060708ULL;
+    uint16_t flags = 0xBEEF;
+    double price = 12.5;
+    int32_t qty[4] = {1, -2, 3, -4};
+    std::vector<char> message(skip_get_data_size(writer) + 64);
+    uint64_t heap_used = 0;
+    skip_write_index_to_buffer(writer, message.data(), message.size(), &id, 0);
+    skip_write_index_to_buffer(writer, message.data(), message.size(), &flags, 1);
+    skip_write_index_to_buffer(writer, message.data(), message.size(), &price, 2);
+    skip_write_index_to_buffer(writer, message.data(), message.size(), qty, 3);
+    assert(skip_write_var_element(writer, message.data(), message.size(), &heap_used, 4, 0, "hello", 5) == SKIP_SUCCESS);
+    uint64_t message_size = skip_get_data_size(writer) + heap_used;
+
+    uint64_t projected_size = skip_get_projected_size(projection, message_size);
+    assert(projected_size == skip_get_data_size(reader) + heap_used);
+    std::vector<char> projected(projected_size, 0x55);
+    assert(skip_project(projection, message.data(), message_size, projected.data(), projected_size - 1) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_project(projection, message.data(), message_size, projected.data(), projected_size) == SKIP_SUCCESS);
+
+    uint64_t id_out = 0;
+    double price_out = 0;
+    int16_t legacy_out[3] = {0};
+    int32_t qty_out[2] = {0};
+    int32_t extra_out[2] = {-1, -1};
+    skip_read_index_from_buffer(reader, projected.data(), projected_size, &id_out, 0);
+    skip_read_index_from_buffer(reader, projected.data(), projected_size, &price_out, 1);
+    skip_read_index_from_buffer(reader, projected.data(), projected_size, legacy_out, 2);
+    skip_read_index_from_buffer(reader, projected.data(), projected_size, qty_out, 3);
+    skip_read_index_from_buffer(reader, projected.data(), projected_size, extra_out, 5);
+    assert(id_out == id && price_out == price);
+    assert(legacy_out[0] == -2 && legacy_out[1] == -2 && legacy_out[2] == -2);
+    assert(qty_out[0] == 1 && qty_out[1] == -2);
+    assert(extra_out[0] == 0 && extra_out[1] == 0);
+    SkipIoVec view;
+    assert(skip_read_var_element(reader, projected.data(), projected_size, 4, 0, &view) == SKIP_SUCCESS);
+    assert(view.len == 5 && memcmp(view.base, "hello", 5) == 0);
+    skip_free_projection(projection);
+    std::cout << "Added, removed and resized fields project in one pass." << std::endl;
+
+    // Unnamed fields match by position, and the writer's extra elements fill
+    // nothing beyond the reader's count.
+    void* old_writer = skip_create_base_config();
+    skip_push_type_to_config(old_writer, skip_int32, 1);
+    skip_push_type_to_config(old_writer, skip_int8, 2);
+    void* new_reader = skip_create_base_config();
+    skip_push_type_to_config(new_reader, skip_int32, 1);
+    skip_push_type_to_config(new_reader, skip_int8, 4);
+    skip_push_type_to_config(new_reader, skip_float32, 1);
+    assert(skip_create_projection(&projection, old_writer, new_reader) == SKIP_SUCCESS);
+    assert(skip_get_projection_source(projection, 2) == SKIP_ERROR_UNKNOWN_FIELD);
+    int8_t pad = 9;
+    float ratio_default = 0.25f;
+    assert(skip_set_projection_default(projection, 1, &pad) == SKIP_SUCCESS);
+    assert(skip_set_projection_default(projection, 2, &ratio_default) == SKIP_SUCCESS);
+    const char old_message[6] = {1, 0, 0, 0, 5, 6};
+    std::vector<char> upgraded(skip_get_projected_size(projection, sizeof(old_message)));
+    assert(upgraded.size() == 12);
+    assert(skip_project(projection, old_message, sizeof(old_message), upgraded.data(), upgraded.size()) == SKIP_SUCCESS);
+    int8_t small[4] = {0};
+    float ratio_out = 0;
+    skip_read_index_from_buffer(new_reader, upgraded.data(), upgraded.size(), small, 1);
+    skip_read_index_from_buffer(new_reader, upgraded.data(), upgraded.size(), &ratio_out, 2);
+    assert(memcmp(upgraded.data(), old_message, 4) == 0);
+    assert(small[0] == 5 && small[1] == 6 && small[2] == 9 && small[3] == 9);
+    assert(ratio_out == 0.25f);
+    skip_free_projection(projection);
+
+    // A field that changed type cannot be projected.
+    skip_pop_type_from_config(new_reader);
+    skip_push_type_to_config(new_reader, skip_int64, 1);
+    skip_pop_type_from_config(old_writer);
+    skip_push_type_to_config(old_writer, skip_uint8, 2);
+    assert(skip_create_projection(&projection, old_writer, new_reader) == SKIP_ERROR_INVALID_CONFIG);
+    assert(projection == NULL);
+    skip_free_cfg(old_writer);
+    skip_free_cfg(new_reader);
+    std::cout << "Positional matching, defaults and type checks work." << std::endl;
+
+    skip_free_cfg(writer);
+    skip_free_cfg(reader);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_partial_reads() {
+    std::cout << "--- Testing Partial Field Reads ---" << std::endl;
+
+    int other = skip_get_system_endian() == SKIP_BIG_ENDIAN ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN;
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, other);
+    skip_push_named_type_to_config(config, "stamp", skip_char, 16);
+    skip_push_named_type_to_config(config, "samples", skip_float64, 100000);
+    skip_push_named_type_to_config(config, "seq", skip_uint32, 1);
+    skip_push_named_type_to_config(config, "note", skip_string, 1);
+
+    uint64_t data_size = skip_get_data_size(config);
+    std::vector<char> data(data_size);
+    std::vector<double> samples(100000);
+    for (size_t i = 0; i < samples.size(); ++i) samples[i] = 0.5 * (double)i;
+    uint32_t seq = 0xA1B2C3D4;
+    skip_write_index_to_buffer(config, data.data(), data_size, (void*)"2026-10-17T12:00", 0);
+    skip_write_index_to_buffer(config, data.data(), data_size, samples.data(), 1);
+    skip_write_index_to_buffer(config, data.data(), data_size, &seq, 2);
+
+    uint64_t standalone_size = skip_export_standalone_size(config);
+    std::vector<char> standalone(standalone_size);
+    assert(skip_export_standalone(config, data.data(), data_size, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    void* imported = NULL;
+    assert(skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size) == SKIP_SUCCESS);
+
+    // One field, a window of an array, and the tail of the same array.
+    char stamp[16];
+    double window[3];
+    double tail[2];
+    uint32_t seq_out = 0;
+    const SkipFieldRange ranges[4] = {
+        {0, 0, 0, stamp},
+        {1, 500 * sizeof(double), sizeof(window), window},
+        {1, 99998 * sizeof(double), 0, tail},
+        {2, 0, 0, &seq_out},
+    };
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size, ranges, 4) == SKIP_SUCCESS);
+    assert(memcmp(stamp, "2026-10-17T12:00", 16) == 0);
+    assert(window[0] == 250.0 && window[1] == 250.5 && window[2] == 251.0);
+    assert(tail[0] == 49999.0 && tail[1] == 49999.5);
+    assert(seq_out == seq);
+
+    SkipFieldRange bad = {1, 4, 8, window};
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size, &bad, 1) == SKIP_ERROR_INVALID_ARGUMENT);
+    bad = {1, 99999 * sizeof(double), 16, window};
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size, &bad, 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+    bad = {4, 0, 0, window};
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size, &bad, 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+    bad = {3, 0, 0, window};
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size, &bad, 1) == SKIP_ERROR_INVALID_ARGUMENT);
+    assert(skip_standalone_read_fields(imported, standalone.data(), standalone_size - 8, &ranges[3], 1) == SKIP_ERROR_BUFFER_TOO_SMALL);
+
+    // The config must match the buffer's byte order and cover its fields.
+    skip_set_endian_value_cfg(config, skip_get_system_endian());
+    assert(skip_standalone_read_fields(config, standalone.data(), standalone_size, ranges, 1) == SKIP_ERROR_INVALID_CONFIG);
+    skip_set_endian_value_cfg(config, other);
+    skip_push_type_to_config(config, skip_int64, 1);
+    assert(skip_standalone_read_fields(config, standalone.data(), standalone_size, ranges, 1) == SKIP_ERROR_INVALID_CONFIG);
+    skip_pop_type_from_config(config);
+    std::cout << "Fields and array windows decode from a standalone buffer." << std::endl;
+
+    // The same ranges through pread; only the header and type table are
+    // read when the file is opened.
+    const char* path = "skip_pread_test.skip";
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    assert(fwrite(standalone.data(), 1, standalone_size, file) == standalone_size);
+    fclose(file);
+
+    file = fopen(path, "rb");
+    void* reader = skip_pread_open(fileno(file));
+    assert(reader != NULL);
+    assert(skip_field_index(skip_pread_get_cfg(reader), "seq") == 2);
+    memset(stamp, 0, sizeof(stamp));
+    memset(window, 0, sizeof(window));
+    seq_out = 0;
+    assert(skip_pread_fields(reader, ranges, 4) == SKIP_SUCCESS);
+    assert(memcmp(stamp, "2026-10-17T12:00", 16) == 0);
+    assert(window[0] == 250.0 && window[2] == 251.0);
+    assert(tail[1] == 49999.5 && seq_out == seq);
+    skip_pread_close(reader);
+    fclose(file);
+
+    // A file that shrinks after opening fails on reads past its new end.
+    file = fopen(path, "rb");
+    reader = skip_pread_open(fileno(file));
+    assert(reader != NULL);
+    FILE* rewrite = fopen(path, "wb");
+    fwrite(standalone.data(), 1, standalone_size - 24, rewrite);
+    fclose(rewrite);
+    assert(skip_pread_fields(reader, &ranges[1], 1) == SKIP_SUCCESS);
+    assert(skip_pread_fields(reader, &ranges[3], 1) == SKIP_ERROR_IO_FAILED);
+    skip_pread_close(reader);
+
+    // Truncated files and headers whose sizes exceed the file are rejected
+    // before the table is read.
+    reader = skip_pread_open(fileno(file));
+    assert(reader == NULL);
+    fclose(file);
+    std::vector<char> forged(standalone.begin(), standalone.begin() + 64);
+    for (int b = 0; b < 8; ++b) forged[8 + b] = (char)0xFF;
+    file = fopen(path, "wb");
+    fwrite(forged.data(), 1, forged.size(), file);
+    fclose(file);
+    file = fopen(path, "rb");
+    assert(skip_pread_open(fileno(file)) == NULL);
+    fclose(file);
+    assert(skip_pread_open(-1) == NULL);
+    remove(path);
+    std::cout << "Fields and array windows decode from a file with pread." << std::endl;
+
+    skip_free_cfg(imported);
+    skip_free_cfg(config);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_element_ranges() {
+    std::cout << "--- Testing Element Ranges ---" << std::endl;
+
+    const int endians[] = {SKIP_LITTLE_ENDIAN, SKIP_BIG_ENDIAN};
+    for (int endian : endians) {
+        void* config = skip_create_base_config();
+        skip_set_endian_value_cfg(config, endian);
+        skip_push_type_to_config(config, skip_int16, 1);
+        skip_push_type_to_config(config, skip_float64, 1000);
+        skip_push_type_to_config(config, skip_string, 1);
+        if (endian == SKIP_BIG_ENDIAN) skip_compile_config(config);
+
+        uint64_t data_size = skip_get_data_size(config);
+        std::vector<char> buffer(data_size);
+        std::vector<double> values(1000);
+        for (int i = 0; i < 1000; ++i) values[i] = i * 1.5;
+        assert(skip_write_index_to_buffer(config, buffer.data(), data_size, values.data(), 1) == SKIP_SUCCESS);
+        std::vector<char> before = buffer;
+
+        // Updating a slice leaves every other byte as it was.
+        const double update[3] = {-1.0, -2.0, -3.0};
+        assert(skip_write_index_range(config, buffer.data(), data_size, update, 1, 500, 3) == SKIP_SUCCESS);
+        uint64_t field_offset = 2;
+        assert(memcmp(buffer.data(), before.data(), field_offset + 500 * sizeof(double)) == 0);
+        assert(memcmp(buffer.data() + field_offset + 503 * sizeof(double), before.data() + field_offset + 503 * sizeof(double),
+                      data_size - field_offset - 503 * sizeof(double)) == 0);
+
+        double window[5];
+        assert(skip_read_index_range(config, buffer.data(), data_size, window, 1, 499, 5) == SKIP_SUCCESS);
+        assert(window[0] == 499 * 1.5 && window[1] == -1.0 && window[3] == -3.0 && window[4] == 503 * 1.5);
+        std::vector<double> all(1000);
+        assert(skip_read_index_from_buffer(config, buffer.data(), data_size, all.data(), 1) == SKIP_SUCCESS);
+        assert(all[501] == -2.0 && all[999] == 999 * 1.5);
+
+        // Gathers mix runs and single elements in any order.
+        const uint64_t picks[6] = {999, 0, 1, 2, 500, 7};
+        double gathered[6];
+        assert(skip_gather_index_elements(config, buffer.data(), data_size, gathered, 1, picks, 6) == SKIP_SUCCESS);
+        assert(gathered[0] == 999 * 1.5 && gathered[1] == 0 && gathered[2] == 1.5 && gathered[3] == 3.0);
+        assert(gathered[4] == -1.0 && gathered[5] == 7 * 1.5);
+
+        int16_t id = 0x1234;
+        int16_t id_out = 0;
+        assert(skip_write_index_range(config, buffer.data(), data_size, &id, 0, 0, 1) == SKIP_SUCCESS);
+        assert(skip_read_index_from_buffer(config, buffer.data(), data_size, &id_out, 0) == SKIP_SUCCESS);
+        assert(id_out == id);
+        assert(skip_write_index_range(config, buffer.data(), data_size, update, 1, 1000, 0) == SKIP_SUCCESS);
+
+        const uint64_t bad_pick = 1000;
+        assert(skip_read_index_range(config, buffer.data(), data_size, window, 1, 998, 3) == SKIP_ERROR_OUT_OF_BOUNDS);
+        assert(skip_write_index_range(config, buffer.data(), data_size, update, 3, 0, 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+        assert(skip_read_index_range(config, buffer.data(), data_size, window, 2, 0, 1) == SKIP_ERROR_INVALID_ARGUMENT);
+        assert(skip_read_index_range(config, buffer.data(), 100, window, 1, 0, 1) == SKIP_ERROR_BUFFER_TOO_SMALL);
+        assert(skip_gather_index_elements(config, buffer.data(), data_size, gathered, 1, &bad_pick, 1) == SKIP_ERROR_OUT_OF_BOUNDS);
+        skip_free_cfg(config);
+    }
+    std::cout << "Slices and gathers touch only the selected elements." << std::endl;
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
+void test_endian_conversion() {
+    std::cout << "--- Testing In-Place Endian Conversion ---" << std::endl;
+
+    int source = SKIP_BIG_ENDIAN;
+    int target = SKIP_LITTLE_ENDIAN;
+
+    // A child message with a compact table, nested in the parent.
+    void* child = skip_create_base_config();
+    skip_set_endian_value_cfg(child, source);
+    skip_set_header_format_cfg(child, SKIP_HEADER_FORMAT_COMPACT);
+    skip_push_type_to_config(child, skip_uint16, 3);
+    skip_push_type_to_config(child, skip_int64, 1);
+    uint64_t child_size = skip_get_data_size(child);
+    std::vector<char> child_data(child_size);
+    const uint16_t child_shorts[3] = {1, 0x0203, 0xFFFE};
+    int64_t child_long = -5000000000LL;
+    skip_write_index_to_buffer(child, child_data.data(), child_size, (void*)child_shorts, 0);
+    skip_write_index_to_buffer(child, child_data.data(), child_size, &child_long, 1);
+    uint64_t nest_size = sizeof(uint64_t) + skip_get_export_header_body_size(child) + child_size;
+    std::vector<char> nest(nest_size);
+    assert(skip_create_nest_buffer(child, nest.data(), nest_size, child_data.data(), child_size) == SKIP_SUCCESS);
+
+    void* config = skip_create_base_config();
+    skip_set_endian_value_cfg(config, source);
+    skip_push_named_type_to_config(config, "id", skip_int32, 1);
+    skip_push_named_type_to_config(config, "tag", skip_char, 5);
+    skip_push_type_to_config(config, skip_float64, 3);
+    skip_push_type_to_config(config, skip_int16, 1);
+    skip_push_type_to_config(config, skip_nest, nest_size);
+    skip_push_type_to_config(config, skip_string, 1);
+    skip_push_type_to_config(config, skip_array | skip_int32, 2);
+    skip_compile_config(config);
+
+    uint64_t fixed_size = skip_get_data_size(config);
+    std::vector<char> buffer(fixed_size + 128);
+    uint64_t heap_used = 0;
+    int32_t id = 0x11223344;
+    const double doubles[3] = {1.5, -2.25, 1e300};
+    int16_t small = -2;
+    const int32_t ints[3] = {7, -8, 0x01020304};
+    skip_write_index_to_buffer(config, buffer.data(), buffer.size(), &id, 0);
+    skip_write_index_to_buffer(config, buffer.data(), buffer.size(), (void*)"gate", 1);
+    skip_write_index_to_buffer(config, buffer.data(), buffer.size(), (void*)doubles, 2);
+    skip_write_index_to_buffer(config, buffer.data(), buffer.size(), &small, 3);
+    skip_write_index_to_buffer(config, buffer.data(), buffer.size(), nest.data(), 4);
+    skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 5, 0, "forward", 7);
+    skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 6, 0, ints, 3);
+    skip_write_var_element(config, buffer.data(), buffer.size(), &heap_used, 6, 1, ints, 1);
+    uint64_t message_size = fixed_size + heap_used;
+    std::vector<char> original(buffer.begin(), buffer.begin() + message_size);
+
+    // Converting with the old config and reading with a retargeted copy.
+    assert(skip_convert_endian_inplace(config, buffer.data(), message_size, 7) == SKIP_ERROR_INVALID_ARGUMENT);
+    assert(skip_convert_endian_inplace(config, buffer.data(), fixed_size - 1, target) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_convert_endian_inplace(config, buffer.data(), message_size, target) == SKIP_SUCCESS);
+    assert(memcmp(buffer.data() + 4, "gate", 5) == 0);
+    skip_set_endian_value_cfg(config, target);
+
+    int32_t id_out = 0;
+    double doubles_out[3];
+    int16_t small_out = 0;
+    skip_read_index_from_buffer(config, buffer.data(), message_size, &id_out, 0);
+    skip_read_index_from_buffer(config, buffer.data(), message_size, doubles_out, 2);
+    skip_read_index_from_buffer(config, buffer.data(), message_size, &small_out, 3);
+    assert(id_out == id && small_out == small);
+    assert(memcmp(doubles_out, doubles, sizeof(doubles)) == 0);
+    SkipIoVec view;
+    assert(skip_read_var_element(config, buffer.data(), message_size, 5, 0, &view) == SKIP_SUCCESS);
+    assert(view.len == 7 && memcmp(view.base, "forward", 7) == 0);
+    int32_t ints_out[3];
+    uint64_t ints_count = 0;
+    assert(skip_read_array_element(config, buffer.data(), message_size, 6, 0, ints_out, 3, &ints_count) == SKIP_SUCCESS);
+    assert(ints_count == 3 && memcmp(ints_out, ints, sizeof(ints)) == 0);
+    assert(skip_read_array_element(config, buffer.data(), message_size, 6, 1, ints_out, 3, &ints_count) == SKIP_SUCCESS);
+    assert(ints_count == 1 && ints_out[0] == ints[0]);
+
+    SkipView root;
+    SkipView nested;
+    assert(skip_view_init(&root, NULL, config, buffer.data(), message_size) == SKIP_SUCCESS);
+    assert(skip_view_get_child(&root, 4, &nested) == SKIP_SUCCESS);
+    assert(skip_get_cfg_endian(skip_view_get_cfg(&nested)) == target);
+    uint16_t child_shorts_out[3];
+    int64_t child_long_out = 0;
+    assert(skip_view_read_index(&nested, 0, child_shorts_out) == SKIP_SUCCESS);
+    assert(skip_view_read_index(&nested, 1, &child_long_out) == SKIP_SUCCESS);
+    assert(memcmp(child_shorts_out, child_shorts, sizeof(child_shorts)) == 0 && child_long_out == child_long);
+    skip_view_release(&nested);
+    skip_view_release(&root);
+
+    // Converting to the config's own order changes nothing; converting back
+    // restores the original bytes.
+    std::vector<char> converted(buffer.begin(), buffer.begin() + message_size);
+    assert(skip_convert_endian_inplace(config, buffer.data(), message_size, target) == SKIP_SUCCESS);
+    assert(memcmp(buffer.data(), converted.data(), message_size) == 0);
+    assert(skip_convert_endian_inplace(config, buffer.data(), message_size, source) == SKIP_SUCCESS);
+    assert(memcmp(buffer.data(), original.data(), message_size) == 0);
+    std::cout << "Fields, heaps and nested blobs convert in place." << std::endl;
+
+    // A corrupt heap slot after a valid nest is caught before anything is
+    // swapped, so the buffer is left as it was.
+    skip_set_endian_value_cfg(config, source);
+    std::vector<char> corrupt(original);
+    uint8_t* slot = (uint8_t*)skip_get_index_ptr(config, corrupt.data(), 6) + 16;
+    memset(slot, 0xFF, 16);
+    std::vector<char> corrupt_copy(corrupt);
+    assert(skip_convert_endian_inplace(config, corrupt.data(), message_size, target) == SKIP_ERROR_OUT_OF_BOUNDS);
+    assert(memcmp(corrupt.data(), corrupt_copy.data(), message_size) == 0);
+
+    // Nesting deeper than the library's limit is rejected, also unchanged.
+    void* level = skip_create_base_config();
+    skip_set_endian_value_cfg(level, source);
+    skip_push_type_to_config(level, skip_int32, 1);
+    std::vector<char> chain(sizeof(int32_t));
+    skip_write_index_to_buffer(level, chain.data(), chain.size(), &id, 0);
+    std::vector<char> chain_copy;
+    for (int depth = 0; depth < 70; ++depth) {
+        uint64_t wrapped_size = sizeof(uint64_t) + skip_get_export_header_body_size(level) + chain.size();
+        std::vector<char> wrapped(wrapped_size);
+        assert(skip_create_nest_buffer(level, wrapped.data(), wrapped_size, chain.data(), chain.size()) == SKIP_SUCCESS);
+        skip_free_cfg(level);
+        level = skip_create_base_config();
+        skip_set_endian_value_cfg(level, source);
+        skip_push_type_to_config(level, skip_nest, wrapped_size);
+        chain.swap(wrapped);
+        if (depth == 2) {
+            chain_copy = chain;
+            assert(skip_convert_endian_inplace(level, chain.data(), chain.size(), target) == SKIP_SUCCESS);
+            assert(memcmp(chain.data(), chain_copy.data(), chain.size()) != 0);
+            skip_set_endian_value_cfg(level, target);
+            assert(skip_convert_endian_inplace(level, chain.data(), chain.size(), source) == SKIP_SUCCESS);
+            skip_set_endian_value_cfg(level, source);
+            assert(memcmp(chain.data(), chain_copy.data(), chain.size()) == 0);
+        }
+    }
+    chain_copy = chain;
+    assert(skip_convert_endian_inplace(level, chain.data(), chain.size(), target) == SKIP_ERROR_INVALID_CONFIG);
+    assert(memcmp(chain.data(), chain_copy.data(), chain.size()) == 0);
+    skip_free_cfg(level);
+    std::cout << "Corrupt or too deeply nested buffers are left unchanged." << std::endl;
+
+    // Standalone buffers also get their type table and endian byte updated.
+    uint64_t standalone_size = skip_export_standalone_size(config) + heap_used;
+    std::vector<char> standalone(standalone_size);
+    assert(skip_export_standalone(config, original.data(), message_size, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(skip_convert_standalone_endian_inplace(standalone.data(), standalone_size - 1, target) == SKIP_ERROR_BUFFER_TOO_SMALL);
+    assert(skip_convert_standalone_endian_inplace(standalone.data(), standalone_size, target) == SKIP_SUCCESS);
+
+    void* imported = NULL;
+    assert(skip_import_standalone_get_cfg(&imported, standalone.data(), standalone_size) == SKIP_SUCCESS);
+    assert(skip_get_cfg_endian(imported) == target);
+    assert(strcmp(skip_get_field_name(imported, 1), "tag") == 0);
+    std::vector<char> data(message_size);
+    assert(skip_import_standalone_get_data_buffer(imported, standalone.data(), standalone_size, data.data(), message_size) == SKIP_SUCCESS);
+    assert(skip_convert_endian_inplace(imported, data.data(), message_size, source) == SKIP_SUCCESS);
+    assert(memcmp(data.data(), original.data(), message_size) == 0);
+    skip_free_cfg(imported);
+    std::cout << "Standalone buffers convert in place." << std::endl;
+
+    skip_free_cfg(config);
+    skip_free_cfg(child);
+    std::cout << "--- Test Passed ---" << std::endl << std::endl;
+}
+
 int main() {
+    test_header_without_init();
+
     skip_init();
 
     test_new_datatypes();
@@ -338,6 +2452,29 @@ int main() {
     test_import_export();
     test_endianness();
     test_error_handling();
+    test_simd_swap_kernels();
+    test_compiled_config();
+    test_write_read_all();
+    test_struct_map();
+    test_record_array();
+    test_columnar_records();
+    test_mmap_reader();
+    test_streaming();
+    test_nest_and_standalone_export();
+    test_allocators();
+    test_config_cache();
+    test_schema_framing();
+    test_compact_header_body();
+    test_nested_views();
+    test_var_length_fields();
+    test_dynamic_arrays();
+    test_parallel_transfer();
+    test_typed_schema();
+    test_field_names();
+    test_schema_projection();
+    test_partial_reads();
+    test_element_ranges();
+    test_endian_conversion();
 
     std::cout << "All tests passed!" << std::endl;
 
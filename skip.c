@@ -4,6 +4,46 @@
 #include <string.h>
 #include "skip.h"
 
+#ifdef _WIN32
+#include <windows.h>
+typedef CRITICAL_SECTION SkipMutex;
+#define skip_mutex_init(m) InitializeCriticalSection(m)
+#define skip_mutex_destroy(m) DeleteCriticalSection(m)
+#define skip_mutex_lock(m) EnterCriticalSection(m)
+#define skip_mutex_unlock(m) LeaveCriticalSection(m)
+#define skip_atomic_add(ptr, v) ((uint32_t)InterlockedExchangeAdd((volatile LONG*)(ptr), (LONG)(v)) + (v))
+#define skip_atomic_fetch_add64(ptr, v) ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(ptr), (LONG64)(v)))
+typedef CONDITION_VARIABLE SkipCond;
+#define skip_cond_init(c) InitializeConditionVariable(c)
+#define skip_cond_destroy(c) ((void)(c))
+#define skip_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define skip_cond_broadcast(c) WakeAllConditionVariable(c)
+typedef HANDLE SkipThread;
+#else
+#include <pthread.h>
+typedef pthread_mutex_t SkipMutex;
+#define skip_mutex_init(m) pthread_mutex_init(m, NULL)
+#define skip_mutex_destroy(m) pthread_mutex_destroy(m)
+#define skip_mutex_lock(m) pthread_mutex_lock(m)
+#define skip_mutex_unlock(m) pthread_mutex_unlock(m)
+#define skip_atomic_add(ptr, v) __atomic_add_fetch(ptr, v, __ATOMIC_ACQ_REL)
+#define skip_atomic_fetch_add64(ptr, v) __atomic_fetch_add(ptr, v, __ATOMIC_RELAXED)
+typedef pthread_cond_t SkipCond;
+#define skip_cond_init(c) pthread_cond_init(c, NULL)
+#define skip_cond_destroy(c) pthread_cond_destroy(c)
+#define skip_cond_wait(c, m) pthread_cond_wait(c, m)
+#define skip_cond_broadcast(c) pthread_cond_broadcast(c)
+typedef pthread_t SkipThread;
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SKIP_HAVE_POSIX 1
+#endif
+
 #define SKIP_MAGIC 0x534B4950 // "SKIP" in ASCII
 
 typedef struct {
@@ -16,10 +56,18 @@ typedef struct {
 } SkipHeader;
 
 
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SKIP_HOST_ENDIAN SKIP_LITTLE_ENDIAN
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SKIP_HOST_ENDIAN SKIP_BIG_ENDIAN
+#endif
+
+#ifndef SKIP_HOST_ENDIAN
 static int is_little_endian() {
     volatile uint32_t i = 0x01234567;
     return (*((volatile uint8_t*)(&i))) == 0x67;
 }
+#endif
 
 static uint16_t swap_uint16(uint16_t val) {
     return (val << 8) | (val >> 8);
@@ -37,8 +85,238 @@ static uint64_t swap_uint64(uint64_t val) {
 }
 
 
+typedef void (*SkipSwapKernel)(uint8_t* dst, const uint8_t* src, uint64_t bytes);
+
+static void skip_copy_kernel(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    if (dst != src) {
+        memcpy(dst, src, (size_t)bytes);
+    }
+}
+
+static void skip_swap16_scalar(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    for (uint64_t i = 0; i + 2 <= bytes; i += 2) {
+        uint16_t val;
+        memcpy(&val, src + i, 2);
+        val = swap_uint16(val);
+        memcpy(dst + i, &val, 2);
+    }
+}
+
+static void skip_swap32_scalar(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    for (uint64_t i = 0; i + 4 <= bytes; i += 4) {
+        uint32_t val;
+        memcpy(&val, src + i, 4);
+        val = swap_uint32(val);
+        memcpy(dst + i, &val, 4);
+    }
+}
+
+static void skip_swap64_scalar(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    for (uint64_t i = 0; i + 8 <= bytes; i += 8) {
+        uint64_t val;
+        memcpy(&val, src + i, 8);
+        val = swap_uint64(val);
+        memcpy(dst + i, &val, 8);
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SKIP_HAVE_X86_SIMD 1
+#include <immintrin.h>
+
+// SSE2 has no byte shuffle, so the swaps are built from 16-bit rotates
+// followed by word shuffles inside each 64-bit half.
+__attribute__((target("sse2")))
+static __m128i skip_sse2_swap16_vec(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+__attribute__((target("sse2")))
+static void skip_swap16_sse2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), skip_sse2_swap16_vec(v));
+    }
+    skip_swap16_scalar(dst + i, src + i, bytes - i);
+}
+
+__attribute__((target("sse2")))
+static void skip_swap32_sse2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = skip_sse2_swap16_vec(_mm_loadu_si128((const __m128i*)(src + i)));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+    skip_swap32_scalar(dst + i, src + i, bytes - i);
+}
+
+__attribute__((target("sse2")))
+static void skip_swap64_sse2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    uint64_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = skip_sse2_swap16_vec(_mm_loadu_si128((const __m128i*)(src + i)));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+    skip_swap64_scalar(dst + i, src + i, bytes - i);
+}
+
+#define SKIP_SHUFFLE_MASK_16 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+#define SKIP_SHUFFLE_MASK_32 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+#define SKIP_SHUFFLE_MASK_64 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7
+
+__attribute__((target("avx2")))
+static void skip_swap_avx2(uint8_t* dst, const uint8_t* src, uint64_t bytes, __m256i mask) {
+    uint64_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_shuffle_epi8(v, mask));
+    }
+    if (i < bytes) {
+        uint8_t tail[32] = {0};
+        memcpy(tail, src + i, (size_t)(bytes - i));
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)tail), mask);
+        _mm256_storeu_si256((__m256i*)tail, v);
+        memcpy(dst + i, tail, (size_t)(bytes - i));
+    }
+}
+
+__attribute__((target("avx2")))
+static void skip_swap16_avx2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx2(dst, src, bytes, _mm256_set_epi8(SKIP_SHUFFLE_MASK_16, SKIP_SHUFFLE_MASK_16));
+}
+
+__attribute__((target("avx2")))
+static void skip_swap32_avx2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx2(dst, src, bytes, _mm256_set_epi8(SKIP_SHUFFLE_MASK_32, SKIP_SHUFFLE_MASK_32));
+}
+
+__attribute__((target("avx2")))
+static void skip_swap64_avx2(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx2(dst, src, bytes, _mm256_set_epi8(SKIP_SHUFFLE_MASK_64, SKIP_SHUFFLE_MASK_64));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void skip_swap_avx512(uint8_t* dst, const uint8_t* src, uint64_t bytes, __m512i mask) {
+    uint64_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        __m512i v = _mm512_loadu_si512((const void*)(src + i));
+        _mm512_storeu_si512((void*)(dst + i), _mm512_shuffle_epi8(v, mask));
+    }
+    if (i < bytes) {
+        __mmask64 tail = (~0ULL) >> (64 - (bytes - i));
+        __m512i v = _mm512_maskz_loadu_epi8(tail, src + i);
+        _mm512_mask_storeu_epi8(dst + i, tail, _mm512_shuffle_epi8(v, mask));
+    }
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static __m512i skip_avx512_mask(__m128i lane) {
+    return _mm512_broadcast_i32x4(lane);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void skip_swap16_avx512(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx512(dst, src, bytes, skip_avx512_mask(_mm_set_epi8(SKIP_SHUFFLE_MASK_16)));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void skip_swap32_avx512(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx512(dst, src, bytes, skip_avx512_mask(_mm_set_epi8(SKIP_SHUFFLE_MASK_32)));
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static void skip_swap64_avx512(uint8_t* dst, const uint8_t* src, uint64_t bytes) {
+    skip_swap_avx512(dst, src, bytes, skip_avx512_mask(_mm_set_epi8(SKIP_SHUFFLE_MASK_64)));
+}
+#endif
+
+int skip_get_simd_level() {
+#ifdef SKIP_HAVE_X86_SIMD
+    if (__builtin_cpu_supports("avx512bw")) {
+        return SKIP_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SKIP_SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SKIP_SIMD_SSE2;
+    }
+#endif
+    return SKIP_SIMD_SCALAR;
+}
+
+// Picks the swap routine for one element width. Element widths other than
+// 2, 4 and 8 bytes have no byte order and are copied as-is.
+static SkipSwapKernel skip_select_swap_kernel(uint64_t type_size, int simd_level) {
+    static const SkipSwapKernel scalar[3] = { skip_swap16_scalar, skip_swap32_scalar, skip_swap64_scalar };
+#ifdef SKIP_HAVE_X86_SIMD
+    static const SkipSwapKernel sse2[3] = { skip_swap16_sse2, skip_swap32_sse2, skip_swap64_sse2 };
+    static const SkipSwapKernel avx2[3] = { skip_swap16_avx2, skip_swap32_avx2, skip_swap64_avx2 };
+    static const SkipSwapKernel avx512[3] = { skip_swap16_avx512, skip_swap32_avx512, skip_swap64_avx512 };
+#endif
+    const SkipSwapKernel* table = scalar;
+
+    int width;
+    switch (type_size) {
+        case 2: width = 0; break;
+        case 4: width = 1; break;
+        case 8: width = 2; break;
+        default: return skip_copy_kernel;
+    }
+
+#ifdef SKIP_HAVE_X86_SIMD
+    switch (simd_level) {
+        case SKIP_SIMD_AVX512: table = avx512; break;
+        case SKIP_SIMD_AVX2: table = avx2; break;
+        case SKIP_SIMD_SSE2: table = sse2; break;
+        default: break;
+    }
+#else
+    (void)simd_level;
+#endif
+
+    return table[width];
+}
+
+int skip_swap_elements(void* dst, const void* src, uint64_t type_size, uint64_t count, int simd_level) {
+    if ((!dst || !src) && count > 0) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (simd_level == SKIP_SIMD_AUTO) {
+        simd_level = skip_get_simd_level();
+    } else if (simd_level < SKIP_SIMD_SCALAR || simd_level > skip_get_simd_level()) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    skip_select_swap_kernel(type_size, simd_level)((uint8_t*)dst, (const uint8_t*)src, type_size * count);
+    return SKIP_SUCCESS;
+}
+
+
+
+// Everything the read/write paths need for one field, resolved ahead of time
+// by skip_compile_config so the hot path is a bounds check and one call.
+typedef struct {
+    uint64_t offset;
+    uint64_t byte_len;
+    uint64_t type_size;
+    SkipSwapKernel kernel;
+} SkipFieldPlan;
+
+typedef struct {
+    uint64_t offset;
+    uint64_t length;
+} SkipFieldName;
 
 typedef struct {
+    SkipAllocator allocator;
+
     SkipInternalType* types;
     uint64_t types_size;
     uint64_t types_capacity;
@@ -47,67 +325,127 @@ typedef struct {
     uint64_t offsets_size;
     uint64_t offsets_capacity;
     int endian;
+    int layout;
+    int header_format;
+
+    SkipFieldPlan* plan;
+    uint64_t plan_capacity;
+    int compiled;
+    uint64_t fingerprint;
+
+    // Optional field names, NUL-terminated in one pool. Fields at or past
+    // field_names_size, and entries with length 0, have no name.
+    char* names;
+    uint64_t names_size;
+    uint64_t names_capacity;
+    // Bytes of names that were replaced, cleared or popped.
+    uint64_t names_dead;
+    SkipFieldName* field_names;
+    uint64_t field_names_size;
+    uint64_t field_names_capacity;
+    uint64_t named_count;
+
+    // Perfect-hash index over the names, built by skip_compile_config.
+    uint32_t* name_slots;
+    uint32_t* name_displacements;
+    uint64_t name_slot_count;
+    uint64_t name_slot_shift;
+    uint64_t name_bucket_mask;
+    uint64_t name_seed;
+
+    // Configs handed out by a config cache are shared between readers:
+    // they are immutable and freed when the last reference is released.
+    int shared;
+    uint32_t refcount;
 } SkipConfig;
 
-SkipConfig* SKIP_HEADER;
-
-
-int skip_init() {
-    if (SKIP_HEADER) {
-        return SKIP_SUCCESS;
+// Little-endian helpers for fixed wire layouts such as the header.
+static uint64_t skip_load_le(const uint8_t* pos, uint64_t size) {
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < size; ++i) {
+        value |= (uint64_t)pos[i] << (8 * i);
     }
+    return value;
+}
 
-    SKIP_HEADER = skip_create_base_config();
-
-    if (!SKIP_HEADER) {
-        return (int)SKIP_ERROR_FAILED_TO_CREATE_HEADER_CFG;
+static void skip_store_le(uint8_t* pos, uint64_t value, uint64_t size) {
+    for (uint64_t i = 0; i < size; ++i) {
+        pos[i] = (uint8_t)(value >> (8 * i));
     }
+}
 
-    
+// The header layout is fixed and stored little-endian:
+// magic (u32), version (u32), body_size (u64), endian (u8),
+// data_size (u64), reserved (7 bytes).
+#define SKIP_HEADER_MAGIC_OFFSET 0
+#define SKIP_HEADER_VERSION_OFFSET 4
+#define SKIP_HEADER_BODY_SIZE_OFFSET 8
+#define SKIP_HEADER_ENDIAN_OFFSET 16
+#define SKIP_HEADER_DATA_SIZE_OFFSET 17
+#define SKIP_HEADER_RESERVED_OFFSET 25
+#define SKIP_HEADER_SIZE 32
+
+// The header layout is constant, so there is nothing to set up or release.
+int skip_init() {
+    return SKIP_SUCCESS;
+}
 
-    int err = skip_set_endian_value_cfg(SKIP_HEADER, SKIP_LITTLE_ENDIAN);
+int skip_free() {
+    return SKIP_SUCCESS;
+}
 
-    if (err != SKIP_SUCCESS) {
-        return err;
-    }
+static void* skip_default_alloc(void* user, uint64_t size) {
+    (void)user;
+    return malloc((size_t)size);
+}
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_uint32, 1);
-    if (err != SKIP_SUCCESS) {
-        return err;
-    }
+static void* skip_default_realloc(void* user, void* ptr, uint64_t old_size, uint64_t new_size) {
+    (void)user;
+    (void)old_size;
+    return realloc(ptr, (size_t)new_size);
+}
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_uint32, 1);
-    if (err != SKIP_SUCCESS) {
-        return err;
-    }
+static void skip_default_free(void* user, void* ptr, uint64_t size) {
+    (void)user;
+    (void)size;
+    free(ptr);
+}
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_uint64, 1);
-    if (err != SKIP_SUCCESS) {
-        return err;
-    }
+static SkipAllocator skip_global_allocator = { skip_default_alloc, skip_default_realloc, skip_default_free, NULL };
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_uint8, 1);
-    if (err != SKIP_SUCCESS) {
-        return err;
+int skip_set_allocator(const SkipAllocator* allocator) {
+    if (!allocator) {
+        skip_global_allocator.alloc = skip_default_alloc;
+        skip_global_allocator.realloc = skip_default_realloc;
+        skip_global_allocator.free = skip_default_free;
+        skip_global_allocator.user = NULL;
+        return SKIP_SUCCESS;
     }
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_uint64, 1);
-    if (err != SKIP_SUCCESS) {
-        return err;
+    if (!allocator->alloc || !allocator->realloc || !allocator->free) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
     }
 
-    err = skip_push_type_to_config(SKIP_HEADER, skip_char, 7);
+    skip_global_allocator = *allocator;
+    return SKIP_SUCCESS;
+}
 
-    return err;
+// Objects copy the global allocator when they are created and release
+// everything through that copy, so swapping the global allocator never
+// hands a block to an allocator that did not produce it.
+static void* skip_mem_alloc(const SkipAllocator* allocator, uint64_t size) {
+    return allocator->alloc(allocator->user, size);
 }
 
-int skip_free() {
-    return skip_free_cfg(SKIP_HEADER);
+static void skip_mem_free(const SkipAllocator* allocator, void* ptr, uint64_t size) {
+    if (ptr) {
+        allocator->free(allocator->user, ptr, size);
+    }
 }
 
-static int ensure_capacity(void** array, uint64_t* capacity, uint64_t element_size, uint64_t new_capacity) {
+static int ensure_capacity(const SkipAllocator* allocator, void** array, uint64_t* capacity, uint64_t element_size, uint64_t new_capacity) {
     if (*capacity < new_capacity) {
-        void* new_array = realloc(*array, (size_t)(new_capacity * element_size));
+        void* new_array = allocator->realloc(allocator->user, *array, *capacity * element_size, new_capacity * element_size);
         if (!new_array) {
             return SKIP_ERROR_ALLOCATION_FAILED;
         }
@@ -119,37 +457,84 @@ static int ensure_capacity(void** array, uint64_t* capacity, uint64_t element_si
 
 #define SKIP_INITIAL_CAPACITY 5
 #define SKIP_CONFIG_VERSION 211
+#define SKIP_CONFIG_VERSION_COMPACT 212
+// Type tables that carry field names; older readers reject them.
+#define SKIP_CONFIG_VERSION_NAMED 213
+#define SKIP_HEADER_ENTRY_SIZE (sizeof(int32_t) + sizeof(uint64_t))
+#define SKIP_VAR_SLOT_SIZE (2 * sizeof(uint64_t))
+
+void* skip_create_base_config_with_allocator(const SkipAllocator* allocator) {
+    if (!allocator) {
+        allocator = &skip_global_allocator;
+    } else if (!allocator->alloc || !allocator->realloc || !allocator->free) {
+        return NULL;
+    }
 
-void* skip_create_base_config() {
-    SkipConfig* config = (SkipConfig*)malloc(sizeof(SkipConfig));
+    SkipConfig* config = (SkipConfig*)allocator->alloc(allocator->user, sizeof(SkipConfig));
     if (!config) return NULL;
 
+    config->allocator = *allocator;
+
     config->types = NULL;
     config->types_size = 0;
     config->types_capacity = 0;
-    if (ensure_capacity((void**)&config->types, &config->types_capacity, sizeof(SkipInternalType), SKIP_INITIAL_CAPACITY) != 0) {
-        free(config);
+    if (ensure_capacity(allocator, (void**)&config->types, &config->types_capacity, sizeof(SkipInternalType), SKIP_INITIAL_CAPACITY) != 0) {
+        allocator->free(allocator->user, config, sizeof(SkipConfig));
         return NULL;
     }
 
     config->offsets = NULL;
     config->offsets_size = 0;
     config->offsets_capacity = 0;
-    if (ensure_capacity((void**)&config->offsets, &config->offsets_capacity, sizeof(uint64_t), SKIP_INITIAL_CAPACITY) != 0) {
-        free(config->types);
-        free(config);
+    if (ensure_capacity(allocator, (void**)&config->offsets, &config->offsets_capacity, sizeof(uint64_t), SKIP_INITIAL_CAPACITY) != 0) {
+        allocator->free(allocator->user, config->types, config->types_capacity * sizeof(SkipInternalType));
+        allocator->free(allocator->user, config, sizeof(SkipConfig));
         return NULL;
     }
     config->offsets[0] = 0;
     config->offsets_size = 1;
 
     config->endian = skip_get_system_endian();
+    config->layout = SKIP_LAYOUT_ROWS;
+    config->header_format = SKIP_HEADER_FORMAT_FIXED;
+
+    config->plan = NULL;
+    config->plan_capacity = 0;
+    config->compiled = 0;
+    config->fingerprint = 0;
+
+    config->names = NULL;
+    config->names_size = 0;
+    config->names_capacity = 0;
+    config->names_dead = 0;
+    config->field_names = NULL;
+    config->field_names_size = 0;
+    config->field_names_capacity = 0;
+    config->named_count = 0;
+
+    config->name_slots = NULL;
+    config->name_displacements = NULL;
+    config->name_slot_count = 0;
+    config->name_slot_shift = 0;
+    config->name_bucket_mask = 0;
+    config->name_seed = 0;
+
+    config->shared = 0;
+    config->refcount = 1;
 
     return config;
 }
 
+void* skip_create_base_config() {
+    return skip_create_base_config_with_allocator(NULL);
+}
+
 int skip_get_system_endian() {
+#ifdef SKIP_HOST_ENDIAN
+    return SKIP_HOST_ENDIAN;
+#else
     return is_little_endian() ? SKIP_LITTLE_ENDIAN : SKIP_BIG_ENDIAN;
+#endif
 }
 
 int skip_get_cfg_endian(void* cfg) {
@@ -163,25 +548,75 @@ int skip_set_endian_value_cfg(void* cfg, int endian) {
         return SKIP_ERROR_INVALID_ARGUMENT;
     }
     SkipConfig* config = (SkipConfig*)cfg;
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
     if (endian != SKIP_BIG_ENDIAN && endian != SKIP_LITTLE_ENDIAN) {
         return SKIP_ERROR_INVALID_ARGUMENT;
     }
     config->endian = endian;
+    config->compiled = 0;
+    return SKIP_SUCCESS;
+}
+
+int skip_set_record_layout_cfg(void* cfg, int layout) {
+    if (!cfg) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
+    if (layout != SKIP_LAYOUT_ROWS && layout != SKIP_LAYOUT_COLUMNS) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    config->layout = layout;
+    config->compiled = 0;
+    return SKIP_SUCCESS;
+}
+
+int skip_get_record_layout_cfg(void* cfg) {
+    SkipConfig* conf = cfg;
+
+    return conf->layout;
+}
+
+int skip_set_header_format_cfg(void* cfg, int format) {
+    if (!cfg) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
+    if (format != SKIP_HEADER_FORMAT_FIXED && format != SKIP_HEADER_FORMAT_COMPACT) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    config->header_format = format;
+    config->compiled = 0;
     return SKIP_SUCCESS;
 }
 
+int skip_get_header_format_cfg(void* cfg) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    return config->header_format;
+}
+
 int skip_push_type_to_config(void* cfg, int32_t type_code, uint64_t count) {
     SkipConfig* config = (SkipConfig*)cfg;
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
 
     if (config->types_size == config->types_capacity) {
         uint64_t new_cap = config->types_capacity == 0 ? 8 : config->types_capacity * 2;
-        int ret = ensure_capacity((void**)&config->types, &config->types_capacity, sizeof(SkipInternalType), new_cap);
+        int ret = ensure_capacity(&config->allocator, (void**)&config->types, &config->types_capacity, sizeof(SkipInternalType), new_cap);
         if (ret != SKIP_SUCCESS) return ret;
     }
 
     if (config->offsets_size == config->offsets_capacity) {
         uint64_t new_cap = config->offsets_capacity == 0 ? 8 : config->offsets_capacity * 2;
-        int ret = ensure_capacity((void**)&config->offsets, &config->offsets_capacity, sizeof(uint64_t), new_cap);
+        int ret = ensure_capacity(&config->allocator, (void**)&config->offsets, &config->offsets_capacity, sizeof(uint64_t), new_cap);
         if (ret != SKIP_SUCCESS) return ret;
     }
 
@@ -194,53 +629,52 @@ int skip_push_type_to_config(void* cfg, int32_t type_code, uint64_t count) {
 
     config->offsets[config->offsets_size] = new_offset;
     config->offsets_size++;
+    config->compiled = 0;
 
     return SKIP_SUCCESS;
 }
 
 uint64_t skip_get_header_export_size() {
-    if (SKIP_HEADER) {
-        return skip_get_data_size(SKIP_HEADER); 
-    }
-
-    return 0;
+    return SKIP_HEADER_SIZE;
 }
 
-int skip_export_header(void* cfg, char* buffer, uint64_t buffer_size, uint64_t* out_body_size) {
-    void* header_cfg = SKIP_HEADER;
-
-    if (!header_cfg) {
-        return (int)SKIP_ERROR_INIT_THE_SKIP_FIRST;
-    }
-
-    
+// Flags stored in reserved[1] of the header.
+#define SKIP_HEADER_FLAG_FINGERPRINT 0x01
 
-    if (buffer_size < skip_get_header_export_size()) {
+// data_size covers the fixed fields and, for configs with variable-length
+// fields, the heap that follows them.
+static int skip_write_header(SkipConfig* config, char* buffer, uint64_t buffer_size, uint64_t body_size, uint64_t data_size, uint8_t flags) {
+    if (buffer_size < SKIP_HEADER_SIZE) {
         return SKIP_ERROR_BUFFER_TOO_SMALL;
     }
 
-    SkipConfig* config = (SkipConfig*)cfg;
-    uint64_t body_size = skip_get_export_header_body_size(config);
-
-    SkipHeader header;
-    header.magic = SKIP_MAGIC;
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.magic, 0);
-    header.version = SKIP_CONFIG_VERSION;
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.version, 1);
-
-    header.body_size = body_size;
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.body_size, 2);
-
-    header.endian = config->endian;
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.endian, 3);
+    uint8_t* pos = (uint8_t*)buffer;
+    uint32_t version = config->header_format == SKIP_HEADER_FORMAT_COMPACT ? SKIP_CONFIG_VERSION_COMPACT : SKIP_CONFIG_VERSION;
+    if (config->named_count > 0) {
+        version = SKIP_CONFIG_VERSION_NAMED;
+    }
+    skip_store_le(pos + SKIP_HEADER_MAGIC_OFFSET, SKIP_MAGIC, sizeof(uint32_t));
+    skip_store_le(pos + SKIP_HEADER_VERSION_OFFSET, version, sizeof(uint32_t));
+    skip_store_le(pos + SKIP_HEADER_BODY_SIZE_OFFSET, body_size, sizeof(uint64_t));
+    pos[SKIP_HEADER_ENDIAN_OFFSET] = (uint8_t)config->endian;
+    skip_store_le(pos + SKIP_HEADER_DATA_SIZE_OFFSET, data_size, sizeof(uint64_t));
 
-    header.body_size = skip_get_data_size(cfg);
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.endian, 4);
+    uint8_t* reserved = pos + SKIP_HEADER_RESERVED_OFFSET;
+    memset(reserved, 0, SKIP_HEADER_SIZE - SKIP_HEADER_RESERVED_OFFSET);
+    reserved[0] = (uint8_t)config->layout;
+    reserved[1] = flags;
 
+    return SKIP_SUCCESS;
+}
 
-    memset(header.reserved, 0, sizeof(header.reserved));
-    skip_write_index_to_buffer(header_cfg, buffer, buffer_size, &header.reserved, 5);
+int skip_export_header(void* cfg, char* buffer, uint64_t buffer_size, uint64_t* out_body_size) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    uint64_t body_size = skip_get_export_header_body_size(config);
 
+    int err = skip_write_header(config, buffer, buffer_size, body_size, skip_get_data_size(config), 0);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
 
     if (out_body_size) {
         *out_body_size = body_size;
@@ -249,31 +683,36 @@ int skip_export_header(void* cfg, char* buffer, uint64_t buffer_size, uint64_t*
     return SKIP_SUCCESS;
 }
 
-void* skip_import_header(void* buffer, uint64_t buffer_size, uint64_t* out_body_size , uint64_t* out_data_size) {
-
-    void* header_cfg = SKIP_HEADER;
-    if (!header_cfg) {
-        return NULL;
+static int skip_parse_header(void* buffer, uint64_t buffer_size, SkipHeader* header) {
+    if (buffer_size < SKIP_HEADER_SIZE) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
     }
 
+    const uint8_t* pos = (const uint8_t*)buffer;
+    header->magic = (uint32_t)skip_load_le(pos + SKIP_HEADER_MAGIC_OFFSET, sizeof(uint32_t));
+    header->version = (uint32_t)skip_load_le(pos + SKIP_HEADER_VERSION_OFFSET, sizeof(uint32_t));
+    header->body_size = skip_load_le(pos + SKIP_HEADER_BODY_SIZE_OFFSET, sizeof(uint64_t));
+    header->endian = pos[SKIP_HEADER_ENDIAN_OFFSET];
+    header->data_size = skip_load_le(pos + SKIP_HEADER_DATA_SIZE_OFFSET, sizeof(uint64_t));
+    memcpy(header->reserved, pos + SKIP_HEADER_RESERVED_OFFSET, sizeof(header->reserved));
+
+    if (header->magic != SKIP_MAGIC ||
+        (header->version != SKIP_CONFIG_VERSION && header->version != SKIP_CONFIG_VERSION_COMPACT &&
+         header->version != SKIP_CONFIG_VERSION_NAMED)) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
 
+    return SKIP_SUCCESS;
+}
 
-    if (buffer_size < skip_get_header_export_size()) {
+void* skip_import_header(void* buffer, uint64_t buffer_size, uint64_t* out_body_size , uint64_t* out_data_size) {
+    SkipHeader header;
+    if (skip_parse_header(buffer, buffer_size, &header) != SKIP_SUCCESS) {
         return NULL;
     }
 
-    SkipHeader header;
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.magic, 0);
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.version, 1);
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.body_size, 2);
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.endian, 3);
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.data_size, 4);
-    skip_read_index_from_buffer(header_cfg, buffer, buffer_size, &header.reserved, 5);
-
-
-    
-
-    if (header.magic != SKIP_MAGIC || header.version != SKIP_CONFIG_VERSION) {       
+    // Fingerprint frames carry no usable type table at the usual place.
+    if (header.reserved[1] & SKIP_HEADER_FLAG_FINGERPRINT) {
         return NULL;
     }
 
@@ -282,7 +721,14 @@ void* skip_import_header(void* buffer, uint64_t buffer_size, uint64_t* out_body_
         return NULL;
     }
 
-    skip_set_endian_value_cfg(config_ptr, header.endian);
+    if (skip_set_endian_value_cfg(config_ptr, header.endian) != SKIP_SUCCESS ||
+        skip_set_record_layout_cfg(config_ptr, header.reserved[0]) != SKIP_SUCCESS) {
+        skip_free_cfg(config_ptr);
+        return NULL;
+    }
+    if (header.version == SKIP_CONFIG_VERSION_COMPACT) {
+        skip_set_header_format_cfg(config_ptr, SKIP_HEADER_FORMAT_COMPACT);
+    }
     if (out_body_size) {
         *out_body_size = header.body_size;
     }
@@ -296,9 +742,21 @@ void* skip_import_header(void* buffer, uint64_t buffer_size, uint64_t* out_body_
 
 int skip_pop_type_from_config(void* cfg) {
     SkipConfig* config = (SkipConfig*)cfg;
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
     if (config->types_size > 0) {
         config->types_size--;
         config->offsets_size--;
+        config->compiled = 0;
+
+        if (config->field_names_size > config->types_size) {
+            config->field_names_size = config->types_size;
+            if (config->field_names[config->types_size].length > 0) {
+                config->named_count--;
+                config->names_dead += config->field_names[config->types_size].length + 1;
+            }
+        }
     }
     return SKIP_SUCCESS;
 }
@@ -309,16 +767,58 @@ SkipInternalType* skip_get_type_at_index(void* cfg, uint64_t index) {
     return &config->types[index];
 }
 
+static void skip_free_name_index(SkipConfig* config) {
+    SkipAllocator* allocator = &config->allocator;
+    if (config->name_slots) {
+        allocator->free(allocator->user, config->name_slots, config->name_slot_count * sizeof(uint32_t));
+        allocator->free(allocator->user, config->name_displacements, (config->name_bucket_mask + 1) * sizeof(uint32_t));
+    }
+    config->name_slots = NULL;
+    config->name_displacements = NULL;
+    config->name_slot_count = 0;
+    config->name_bucket_mask = 0;
+}
+
 int skip_free_cfg(void* cfg) {
     if (cfg) {
         SkipConfig* config = (SkipConfig*)cfg;
-        free(config->types);
-        free(config->offsets);
-        free(config);
+        if (config->shared && skip_atomic_add(&config->refcount, (uint32_t)-1) != 0) {
+            return SKIP_SUCCESS;
+        }
+        SkipAllocator allocator = config->allocator;
+        allocator.free(allocator.user, config->types, config->types_capacity * sizeof(SkipInternalType));
+        allocator.free(allocator.user, config->offsets, config->offsets_capacity * sizeof(uint64_t));
+        if (config->plan) {
+            allocator.free(allocator.user, config->plan, config->plan_capacity * sizeof(SkipFieldPlan));
+        }
+        if (config->names) {
+            allocator.free(allocator.user, config->names, config->names_capacity);
+        }
+        if (config->field_names) {
+            allocator.free(allocator.user, config->field_names, config->field_names_capacity * sizeof(SkipFieldName));
+        }
+        skip_free_name_index(config);
+        allocator.free(allocator.user, config, sizeof(SkipConfig));
     }
     return SKIP_SUCCESS;
 }
 
+// Size of one heap element of a variable-length type, or 0 if the type is
+// not variable-length. Arrays of variable-length types are not supported.
+static uint64_t skip_get_var_element_size(int32_t type_code) {
+    if (type_code == skip_string || type_code == skip_bytes) {
+        return 1;
+    }
+    if (type_code & skip_array) {
+        int32_t element_type = type_code & ~skip_array;
+        if (element_type == skip_string || element_type == skip_bytes || (element_type & skip_array)) {
+            return 0;
+        }
+        return skip_get_datatype_size(element_type);
+    }
+    return 0;
+}
+
 uint64_t skip_get_datatype_size(int32_t type_code) {
     switch (type_code) {
         case skip_int8: return 1;
@@ -333,8 +833,24 @@ uint64_t skip_get_datatype_size(int32_t type_code) {
         case skip_float64: return 8;
         case skip_nest:
         case skip_char: return 1;
-        default: return 0;
+        case skip_string:
+        case skip_bytes: return SKIP_VAR_SLOT_SIZE;
+        default: break;
+    }
+
+    if (type_code & skip_array) {
+        return skip_get_var_element_size(type_code) ? SKIP_VAR_SLOT_SIZE : 0;
+    }
+    return 0;
+}
+
+// Variable-length fields store (offset, length) pairs of uint64_t, so they
+// are byte-swapped as 8-byte units.
+static uint64_t skip_get_swap_unit(int32_t type_code) {
+    if (skip_get_var_element_size(type_code)) {
+        return sizeof(uint64_t);
     }
+    return skip_get_datatype_size(type_code);
 }
 
 uint64_t skip_get_data_size(void* cfg) {
@@ -343,322 +859,4132 @@ uint64_t skip_get_data_size(void* cfg) {
     return config->offsets[config->offsets_size - 1];
 }
 
-int skip_write_index_to_buffer(void* cfg, void* buffer, uint64_t buffer_size, void* value, uint64_t index) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    if (index >= config->types_size) return SKIP_ERROR_OUT_OF_BOUNDS;
-
-    uint64_t offset = config->offsets[index];
-    uint64_t type_size = skip_get_datatype_size(config->types[index].type_code);
-    uint64_t count = config->types[index].count;
-
-    if (offset + (type_size * count) > buffer_size) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
-    }
-
-    int system_endian = skip_get_system_endian();
-    int config_endian = config->endian;
+// 64-bit hash over little-endian 8-byte words; used to key schemas and
+// names. The result is the same on every host, so it can go on the wire.
+static uint64_t skip_hash_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
 
-    if (type_size == 1 || system_endian == config_endian) {
-        memcpy((uint8_t*)buffer + offset, value, (size_t)(count * type_size));
-    } else {
-        uint8_t* dst_ptr = (uint8_t*)buffer + offset;
-        uint8_t* src_ptr = (uint8_t*)value;
-        for (uint64_t i = 0; i < count; ++i) {
-            switch (type_size) {
-                case 2: {
-                    uint16_t val = swap_uint16(*(uint16_t*)src_ptr);
-                    memcpy(dst_ptr, &val, 2);
-                    break;
-                }
-                case 4: {
-                    uint32_t val = swap_uint32(*(uint32_t*)src_ptr);
-                    memcpy(dst_ptr, &val, 4);
-                    break;
-                }
-                case 8: {
-                    uint64_t val = swap_uint64(*(uint64_t*)src_ptr);
-                    memcpy(dst_ptr, &val, 8);
-                    break;
-                }
-            }
-            src_ptr += type_size;
-            dst_ptr += type_size;
+// Feeds whole words; a trailing partial word is left to skip_hash_finish.
+static uint64_t skip_hash_words(uint64_t h, const uint8_t* pos, uint64_t size) {
+    int little = skip_get_system_endian() == SKIP_LITTLE_ENDIAN;
+    for (; size >= 8; pos += 8, size -= 8) {
+        uint64_t word;
+        if (little) {
+            memcpy(&word, pos, 8);
+        } else {
+            word = skip_load_le(pos, 8);
         }
+        h = skip_hash_mix(h ^ word) + 0x9E3779B97F4A7C15ULL;
     }
+    return h;
+}
 
-    return SKIP_SUCCESS;
+static uint64_t skip_hash_finish(uint64_t h, const uint8_t* pos, uint64_t size) {
+    return skip_hash_mix(h ^ skip_load_le(pos, size));
 }
 
-uint64_t skip_get_export_header_body_size(void* cfg) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    return config->types_size * (sizeof(int32_t) + sizeof(uint64_t));
+static uint64_t skip_hash_bytes(const void* data, uint64_t size, uint64_t seed) {
+    const uint8_t* pos = (const uint8_t*)data;
+    uint64_t h = skip_hash_words(seed ^ (size * 0x9E3779B97F4A7C15ULL), pos, size);
+    return skip_hash_finish(h, pos + (size & ~(uint64_t)7), size & 7);
 }
 
-int skip_export_header_body(void* cfg, char* buffer, uint64_t buffer_size) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    uint64_t required_size = skip_get_export_header_body_size(cfg);
-    if (buffer_size < required_size) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
-    }
+static void skip_export_header_entries(SkipConfig* config, uint64_t first, uint64_t count, char* buffer);
 
-    char* current_pos = buffer;
-    for (uint64_t i = 0; i < config->types_size; ++i) {
-        int32_t type_code = config->types[i].type_code;
-        uint64_t count = config->types[i].count;
+// Equal to skip_hash_bytes over the exported type table. The fixed table
+// is hashed in chunks so no buffer the size of the table is needed; compact
+// and named tables are exported into scratch memory first.
+#define SKIP_FINGERPRINT_CHUNK 64
 
-        if (skip_get_system_endian() != config->endian) {
-            type_code = swap_uint32(type_code);
-            count = swap_uint64(count);
+static int skip_compute_fingerprint(SkipConfig* config, uint64_t* out_fingerprint) {
+    uint64_t seed = ((uint64_t)config->endian << 8) | (uint64_t)config->layout;
+    if (config->header_format == SKIP_HEADER_FORMAT_COMPACT || config->named_count > 0) {
+        uint64_t body_size = skip_get_export_header_body_size(config);
+        char* body = (char*)skip_mem_alloc(&config->allocator, body_size);
+        if (!body) {
+            return SKIP_ERROR_ALLOCATION_FAILED;
         }
-
-        memcpy(current_pos, &type_code, sizeof(int32_t));
-        current_pos += sizeof(int32_t);
-        memcpy(current_pos, &count, sizeof(uint64_t));
-        current_pos += sizeof(uint64_t);
+        skip_export_header_body(config, body, body_size);
+        *out_fingerprint = skip_hash_bytes(body, body_size, seed);
+        skip_mem_free(&config->allocator, body, body_size);
+        return SKIP_SUCCESS;
     }
 
-    return SKIP_SUCCESS;
+    uint8_t chunk[SKIP_FINGERPRINT_CHUNK * SKIP_HEADER_ENTRY_SIZE];
+    uint64_t size = config->types_size * SKIP_HEADER_ENTRY_SIZE;
+    uint64_t h = seed ^ (size * 0x9E3779B97F4A7C15ULL);
+
+    uint64_t first = 0;
+    for (;;) {
+        uint64_t count = config->types_size - first;
+        if (count > SKIP_FINGERPRINT_CHUNK) count = SKIP_FINGERPRINT_CHUNK;
+        skip_export_header_entries(config, first, count, (char*)chunk);
+        first += count;
+
+        uint64_t bytes = count * SKIP_HEADER_ENTRY_SIZE;
+        if (first == config->types_size) {
+            h = skip_hash_words(h, chunk, bytes);
+            *out_fingerprint = skip_hash_finish(h, chunk + (bytes & ~(uint64_t)7), bytes & 7);
+            return SKIP_SUCCESS;
+        }
+        h = skip_hash_words(h, chunk, bytes);
+    }
 }
 
-int skip_import_header_body(void* cfg, const char* buffer, uint64_t buffer_size) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    if (!config) {
-        return SKIP_ERROR_INVALID_ARGUMENT;
+static void skip_build_field_plan(SkipConfig* config, uint64_t index, SkipFieldPlan* field) {
+    uint64_t type_size = skip_get_swap_unit(config->types[index].type_code);
+
+    field->offset = config->offsets[index];
+    field->type_size = type_size;
+    field->byte_len = config->offsets[index + 1] - config->offsets[index];
+
+    if (type_size == 1 || skip_get_system_endian() == config->endian) {
+        field->kernel = skip_copy_kernel;
+    } else {
+        field->kernel = skip_select_swap_kernel(type_size, skip_get_simd_level());
     }
+}
 
-    const char* current_pos = buffer;
-    const char* end_pos = buffer + buffer_size;
-    
-    if (buffer_size % (sizeof(int32_t) + sizeof(uint64_t) != 0)) {
-        return SKIP_ERROR_INVALID_CONFIG;
+// Returns the cached plan entry of a compiled config, or builds one into
+// scratch so uncompiled configs keep working unchanged.
+static const SkipFieldPlan* skip_get_field_plan(SkipConfig* config, uint64_t index, SkipFieldPlan* scratch) {
+    if (config->compiled) {
+        return &config->plan[index];
     }
-    
-    int system_endian = skip_get_system_endian();
-    int config_endian = config->endian;
+    skip_build_field_plan(config, index, scratch);
+    return scratch;
+}
 
-    while (current_pos < end_pos) {
-        int32_t type_code;
-        uint64_t count;
+// Field names. The index is a hash-and-displace perfect hash: a name's hash
+// picks a bucket, and the bucket's displacement picks the one slot the name
+// can occupy, so a lookup is one hash, two loads and one compare.
+#define SKIP_NAME_EMPTY_SLOT UINT32_MAX
+#define SKIP_NAME_HASH_MUL 0x9FB21C651E98DF25ULL
+#define SKIP_NAME_MAX_SEEDS 8
+#define SKIP_NAME_MAX_DISPLACEMENT 4096
+
+static int skip_name_equals(const SkipConfig* config, uint64_t index, const char* name, uint64_t length) {
+    const SkipFieldName* field_name = &config->field_names[index];
+    if (field_name->length != length) {
+        return 0;
+    }
+    const char* stored = config->names + field_name->offset;
+    for (uint64_t i = 0; i < length; ++i) {
+        if (stored[i] != name[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
 
-        memcpy(&type_code, current_pos, sizeof(int32_t));
-        current_pos += sizeof(int32_t);
-        memcpy(&count, current_pos, sizeof(uint64_t));
-        current_pos += sizeof(uint64_t);
+// The index lives only in memory, so unlike the schema hash this one may
+// depend on host byte order. Names are short: most take one or two
+// multiplies.
+static inline uint64_t skip_name_hash(const char* name, uint64_t length, uint64_t seed) {
+    const uint8_t* pos = (const uint8_t*)name;
+    uint64_t h = seed ^ (length * SKIP_NAME_HASH_MUL);
+    for (; length >= 8; pos += 8, length -= 8) {
+        uint64_t word;
+        memcpy(&word, pos, 8);
+        h = (h ^ word) * SKIP_NAME_HASH_MUL;
+        h ^= h >> 29;
+    }
 
-        if (system_endian != config_endian) {
-            type_code = swap_uint32(type_code);
-            count = swap_uint64(count);
-        }
+    uint64_t tail = 0;
+    if (length >= 4) {
+        uint32_t low, high;
+        memcpy(&low, pos, 4);
+        memcpy(&high, pos + length - 4, 4);
+        tail = ((uint64_t)high << 32) | low;
+    } else if (length > 0) {
+        tail = ((uint64_t)pos[0] << 16) | ((uint64_t)pos[length / 2] << 8) | pos[length - 1];
+    }
+    h = (h ^ tail) * SKIP_NAME_HASH_MUL;
+    return h ^ (h >> 32);
+}
 
-        if (skip_push_type_to_config(cfg, type_code, count) != SKIP_SUCCESS) {
-            return SKIP_ERROR_INVALID_CONFIG;
+static uint64_t skip_name_slot(uint64_t hash, uint32_t displacement, uint64_t slot_shift) {
+    return ((hash + displacement * 0x9E3779B97F4A7C15ULL) * SKIP_NAME_HASH_MUL) >> slot_shift;
+}
+
+// Copies the live names into a fresh pool with room for extra more bytes.
+static int skip_compact_names(SkipConfig* config, uint64_t extra) {
+    SkipAllocator* allocator = &config->allocator;
+    uint64_t capacity = config->names_size - config->names_dead + extra;
+    char* names = (char*)allocator->alloc(allocator->user, capacity);
+    if (!names) {
+        return SKIP_ERROR_ALLOCATION_FAILED;
+    }
+
+    uint64_t size = 0;
+    for (uint64_t i = 0; i < config->field_names_size; ++i) {
+        SkipFieldName* field_name = &config->field_names[i];
+        if (field_name->length > 0) {
+            memcpy(names + size, config->names + field_name->offset, field_name->length + 1);
+            field_name->offset = size;
+            size += field_name->length + 1;
         }
     }
 
+    allocator->free(allocator->user, config->names, config->names_capacity);
+    config->names = names;
+    config->names_size = size;
+    config->names_capacity = capacity;
+    config->names_dead = 0;
     return SKIP_SUCCESS;
 }
 
-void* skip_get_index_ptr(void* cfg, void* buffer, uint64_t index) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    if (index >= config->types_size) return NULL;
-    uint64_t offset = config->offsets[index];
-    return (uint8_t*)buffer + offset;
-}
+// Stores without checking for duplicates; length 0 clears the name. A name
+// that fits in the old one's bytes reuses them; otherwise the pool is
+// compacted once more than half of it is dead, so renames cannot grow it
+// without bound.
+static int skip_store_field_name(SkipConfig* config, uint64_t index, const char* name, uint64_t length) {
+    SkipAllocator* allocator = &config->allocator;
+    if (index >= config->field_names_size) {
+        if (length == 0) {
+            return SKIP_SUCCESS;
+        }
+        if (index >= config->field_names_capacity) {
+            uint64_t new_cap = config->field_names_capacity * 2 > index + 1 ? config->field_names_capacity * 2 : index + 1;
+            int err = ensure_capacity(allocator, (void**)&config->field_names, &config->field_names_capacity, sizeof(SkipFieldName), new_cap);
+            if (err != SKIP_SUCCESS) {
+                return err;
+            }
+        }
+        for (uint64_t i = config->field_names_size; i <= index; ++i) {
+            config->field_names[i].offset = 0;
+            config->field_names[i].length = 0;
+        }
+        config->field_names_size = index + 1;
+    }
 
-int skip_read_index_from_buffer(void* cfg, void* buffer, uint64_t buffer_size, void* value, uint64_t index) {
-    SkipConfig* config = (SkipConfig*)cfg;
-    if (index >= config->types_size) return SKIP_ERROR_OUT_OF_BOUNDS;
+    SkipFieldName* field_name = &config->field_names[index];
+    if (length == 0) {
+        if (field_name->length > 0) {
+            config->named_count--;
+            config->names_dead += field_name->length + 1;
+        }
+        field_name->length = 0;
+        return SKIP_SUCCESS;
+    }
 
-    uint64_t offset = config->offsets[index];
-    uint64_t type_size = skip_get_datatype_size(config->types[index].type_code);
-    uint64_t count = config->types[index].count;
+    if (length <= field_name->length) {
+        memcpy(config->names + field_name->offset, name, length);
+        config->names[field_name->offset + length] = '\0';
+        config->names_dead += field_name->length - length;
+        field_name->length = length;
+        return SKIP_SUCCESS;
+    }
 
-    if (offset + (type_size * count) > buffer_size) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    if (config->names_dead > config->names_size / 2) {
+        int err = skip_compact_names(config, length + 1);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
     }
 
-    int system_endian = skip_get_system_endian();
-    int config_endian = config->endian;
+    if (config->names_size + length + 1 > config->names_capacity) {
+        uint64_t needed = config->names_size + length + 1;
+        uint64_t new_cap = config->names_capacity * 2 > needed ? config->names_capacity * 2 : needed;
+        int err = ensure_capacity(allocator, (void**)&config->names, &config->names_capacity, 1, new_cap);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
+    }
 
-    if (type_size == 1 || system_endian == config_endian) {
-        memcpy(value, (uint8_t*)buffer + offset, (size_t)(count * type_size));
+    memcpy(config->names + config->names_size, name, length);
+    config->names[config->names_size + length] = '\0';
+    if (field_name->length > 0) {
+        config->names_dead += field_name->length + 1;
     } else {
-        uint8_t* dst_ptr = (uint8_t*)value;
-        uint8_t* src_ptr = (uint8_t*)buffer + offset;
-        for (uint64_t i = 0; i < count; ++i) {
-            switch (type_size) {
-                case 2: {
-                    uint16_t val;
-                    memcpy(&val, src_ptr, 2);
-                    *(uint16_t*)dst_ptr = swap_uint16(val);
-                    break;
-                }
-                case 4: {
-                    uint32_t val;
-                    memcpy(&val, src_ptr, 4);
-                    *(uint32_t*)dst_ptr = swap_uint32(val);
-                    break;
-                }
-                case 8: {
-                    uint64_t val;
-                    memcpy(&val, src_ptr, 8);
-                    *(uint64_t*)dst_ptr = swap_uint64(val);
+        config->named_count++;
+    }
+    field_name->offset = config->names_size;
+    field_name->length = length;
+    config->names_size += length + 1;
+    return SKIP_SUCCESS;
+}
+
+static int skip_compare_u64_desc(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return x < y ? 1 : (x > y ? -1 : 0);
+}
+
+// Fills slots/displacements for one seed. Returns 0 if some bucket could not
+// be placed.
+static int skip_place_name_buckets(const uint64_t* hashes, const uint32_t* members, const uint64_t* bucket_start, uint64_t* order, uint64_t bucket_count, uint32_t* slots, uint32_t* displacements, uint64_t slot_shift) {
+    for (uint64_t b = 0; b < bucket_count; ++b) {
+        order[b] = ((bucket_start[b + 1] - bucket_start[b]) << 32) | b;
+    }
+    qsort(order, bucket_count, sizeof(uint64_t), skip_compare_u64_desc);
+
+    for (uint64_t i = 0; i < (1ULL << (64 - slot_shift)); ++i) {
+        slots[i] = SKIP_NAME_EMPTY_SLOT;
+    }
+
+    for (uint64_t o = 0; o < bucket_count; ++o) {
+        uint64_t b = order[o] & 0xFFFFFFFFu;
+        uint64_t first = bucket_start[b];
+        uint64_t last = bucket_start[b + 1];
+        displacements[b] = 0;
+        if (first == last) {
+            continue;
+        }
+
+        uint32_t d = 0;
+        for (; d < SKIP_NAME_MAX_DISPLACEMENT; ++d) {
+            uint64_t placed = first;
+            for (; placed < last; ++placed) {
+                uint64_t slot = skip_name_slot(hashes[members[placed]], d, slot_shift);
+                if (slots[slot] != SKIP_NAME_EMPTY_SLOT) {
                     break;
                 }
+                slots[slot] = members[placed];
+            }
+            if (placed == last) {
+                break;
+            }
+            // Undo the partial placement and try the next displacement.
+            for (uint64_t m = first; m < placed; ++m) {
+                slots[skip_name_slot(hashes[members[m]], d, slot_shift)] = SKIP_NAME_EMPTY_SLOT;
             }
-            src_ptr += type_size;
-            dst_ptr += type_size;
         }
+        if (d == SKIP_NAME_MAX_DISPLACEMENT) {
+            return 0;
+        }
+        displacements[b] = d;
     }
-
-    return SKIP_SUCCESS;
+    return 1;
 }
 
+// Builds the index over all named fields. Duplicate names are rejected.
+// If no seed works the config keeps no index and lookups fall back to a
+// scan, which only affects speed.
+static int skip_build_name_index(SkipConfig* config) {
+    skip_free_name_index(config);
+    if (config->named_count == 0 || config->field_names_size >= SKIP_NAME_EMPTY_SLOT) {
+        return SKIP_SUCCESS;
+    }
 
-int skip_create_nest_buffer(void* cfg, void* final_res, uint64_t final_res_size, void* data_buffer, uint64_t data_size) {
-    uint64_t header_body_size = skip_get_export_header_body_size(cfg);
-    if (final_res_size < header_body_size + data_size + sizeof(uint64_t)) {
-        return (int)SKIP_ERROR_BUFFER_TOO_SMALL;
+    uint64_t field_count = config->field_names_size;
+    uint64_t named = config->named_count;
+    uint64_t slot_count = 2;
+    uint64_t slot_shift = 63;
+    while (slot_count < 2 * named) {
+        slot_count <<= 1;
+        slot_shift--;
     }
+    uint64_t bucket_count = 1;
+    while (bucket_count * 4 < named) bucket_count <<= 1;
+
+    SkipAllocator* allocator = &config->allocator;
+    uint32_t* slots = (uint32_t*)allocator->alloc(allocator->user, slot_count * sizeof(uint32_t));
+    uint32_t* displacements = (uint32_t*)allocator->alloc(allocator->user, bucket_count * sizeof(uint32_t));
+    uint64_t* hashes = (uint64_t*)skip_mem_alloc(allocator, field_count * sizeof(uint64_t));
+    uint32_t* members = (uint32_t*)skip_mem_alloc(allocator, named * sizeof(uint32_t));
+    uint64_t* bucket_start = (uint64_t*)skip_mem_alloc(allocator, (bucket_count + 1) * sizeof(uint64_t));
+    uint64_t* order = (uint64_t*)skip_mem_alloc(allocator, bucket_count * sizeof(uint64_t));
+
+    int err = SKIP_ERROR_ALLOCATION_FAILED;
+    int placed = 0;
+    if (slots && displacements && hashes && members && bucket_start && order) {
+        err = SKIP_SUCCESS;
+        for (uint64_t attempt = 0; attempt < SKIP_NAME_MAX_SEEDS && !placed && err == SKIP_SUCCESS; ++attempt) {
+            uint64_t seed = (attempt + 1) * 0x9E3779B97F4A7C15ULL;
+            for (uint64_t b = 0; b <= bucket_count; ++b) {
+                bucket_start[b] = 0;
+            }
+            for (uint64_t i = 0; i < field_count; ++i) {
+                const SkipFieldName* field_name = &config->field_names[i];
+                if (field_name->length > 0) {
+                    hashes[i] = skip_name_hash(config->names + field_name->offset, field_name->length, seed);
+                    bucket_start[((hashes[i] >> 32) & (bucket_count - 1)) + 1]++;
+                }
+            }
+            for (uint64_t b = 0; b < bucket_count; ++b) {
+                bucket_start[b + 1] += bucket_start[b];
+            }
 
-    SkipConfig* config = (SkipConfig*)cfg;
-    uint64_t meta_size_to_write = header_body_size;
+            // Group fields by bucket, then check each bucket for names equal
+            // to one another, which no seed could ever separate.
+            for (uint64_t i = 0; i < field_count; ++i) {
+                if (config->field_names[i].length > 0) {
+                    members[bucket_start[(hashes[i] >> 32) & (bucket_count - 1)]++] = (uint32_t)i;
+                }
+            }
+            for (uint64_t b = bucket_count; b > 0; --b) {
+                bucket_start[b] = bucket_start[b - 1];
+            }
+            bucket_start[0] = 0;
+
+            for (uint64_t b = 0; b < bucket_count && err == SKIP_SUCCESS; ++b) {
+                for (uint64_t x = bucket_start[b]; x < bucket_start[b + 1]; ++x) {
+                    for (uint64_t y = x + 1; y < bucket_start[b + 1]; ++y) {
+                        const SkipFieldName* name = &config->field_names[members[y]];
+                        if (hashes[members[x]] == hashes[members[y]] &&
+                            skip_name_equals(config, members[x], config->names + name->offset, name->length)) {
+                            err = SKIP_ERROR_INVALID_CONFIG;
+                        }
+                    }
+                }
+            }
 
-    if (skip_get_system_endian() != config->endian) {
-        meta_size_to_write = swap_uint64(meta_size_to_write);
+            if (err == SKIP_SUCCESS) {
+                placed = skip_place_name_buckets(hashes, members, bucket_start, order, bucket_count, slots, displacements, slot_shift);
+                config->name_seed = seed;
+            }
+        }
     }
 
+    skip_mem_free(allocator, hashes, field_count * sizeof(uint64_t));
+    skip_mem_free(allocator, members, named * sizeof(uint32_t));
+    skip_mem_free(allocator, bucket_start, (bucket_count + 1) * sizeof(uint64_t));
+    skip_mem_free(allocator, order, bucket_count * sizeof(uint64_t));
+
+    if (err == SKIP_SUCCESS && placed) {
+        config->name_slots = slots;
+        config->name_displacements = displacements;
+        config->name_slot_count = slot_count;
+        config->name_slot_shift = slot_shift;
+        config->name_bucket_mask = bucket_count - 1;
+        return SKIP_SUCCESS;
+    }
+
+    if (slots) allocator->free(allocator->user, slots, slot_count * sizeof(uint32_t));
+    if (displacements) allocator->free(allocator->user, displacements, bucket_count * sizeof(uint32_t));
+    return err;
+}
 
-    void* header_body_buffer = malloc(header_body_size);
-    if (!header_body_buffer) {
-         return SKIP_ERROR_ALLOCATION_FAILED;
+int skip_set_field_name(void* cfg, uint64_t index, const char* name) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
+    if (index >= config->types_size) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
     }
-    int err = skip_export_header_body(cfg, header_body_buffer, header_body_size);
 
+    // Duplicate names are found when the index is built by
+    // skip_compile_config, so naming a field stays O(length).
+    uint64_t length = name ? strlen(name) : 0;
+    int err = skip_store_field_name(config, index, name, length);
     if (err != SKIP_SUCCESS) {
-        free(header_body_buffer);
         return err;
     }
+    config->compiled = 0;
+    return SKIP_SUCCESS;
+}
 
-    memcpy(final_res, &meta_size_to_write, sizeof(uint64_t));
-    memcpy((uint8_t*)final_res + sizeof(uint64_t), header_body_buffer, header_body_size);
-    memcpy((uint8_t*)final_res + sizeof(uint64_t) + header_body_size, data_buffer, data_size);
+int skip_push_named_type_to_config(void* cfg, const char* name, int32_t type_code, uint64_t count) {
+    int err = skip_push_type_to_config(cfg, type_code, count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
 
-    free(header_body_buffer);
-    return (int)SKIP_SUCCESS;
+    SkipConfig* config = (SkipConfig*)cfg;
+    err = skip_set_field_name(cfg, config->types_size - 1, name);
+    if (err != SKIP_SUCCESS) {
+        skip_pop_type_from_config(cfg);
+    }
+    return err;
 }
 
-int skip_get_nest_cfg(void* cfg, void* nest_base_cfg, void* nest_buffer, uint64_t nest_size) {
-    SkipConfig* parent_config = (SkipConfig*)cfg;
-    uint64_t meta_size;
-    memcpy(&meta_size, nest_buffer, sizeof(uint64_t));
+const char* skip_get_field_name(void* cfg, uint64_t index) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || index >= config->field_names_size || config->field_names[index].length == 0) {
+        return NULL;
+    }
+    return config->names + config->field_names[index].offset;
+}
 
-    if (skip_get_system_endian() != parent_config->endian) {
-        meta_size = swap_uint64(meta_size);
+int64_t skip_field_index_n(void* cfg, const char* name, uint64_t length) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !name) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
     }
 
-    if (nest_size < meta_size + sizeof(uint64_t)) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    if (config->compiled && config->name_slots) {
+        uint64_t hash = skip_name_hash(name, length, config->name_seed);
+        uint32_t displacement = config->name_displacements[(hash >> 32) & config->name_bucket_mask];
+        uint32_t index = config->name_slots[skip_name_slot(hash, displacement, config->name_slot_shift)];
+        if (index != SKIP_NAME_EMPTY_SLOT && skip_name_equals(config, index, name, length)) {
+            return index;
+        }
+        return SKIP_ERROR_UNKNOWN_FIELD;
     }
 
-    void* new_buffer_start = (uint8_t*)nest_buffer + sizeof(uint64_t);
+    for (uint64_t i = 0; i < config->field_names_size && length > 0; ++i) {
+        if (skip_name_equals(config, i, name, length)) {
+            return (int64_t)i;
+        }
+    }
+    return SKIP_ERROR_UNKNOWN_FIELD;
+}
 
-    int err = skip_set_endian_value_cfg(nest_base_cfg, skip_get_cfg_endian(cfg));
-    if (err != SKIP_SUCCESS) {
-        return err;
+int64_t skip_field_index(void* cfg, const char* name) {
+    if (!name) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
     }
+    return skip_field_index_n(cfg, name, strlen(name));
+}
 
-    err = skip_import_header_body(nest_base_cfg, new_buffer_start, meta_size);
-    if (err != SKIP_SUCCESS) {
-        return err;
+int skip_compile_config(void* cfg) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
     }
 
-    return SKIP_SUCCESS;
-}
+    if (config->shared) {
+        return config->compiled ? SKIP_SUCCESS : SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
 
-int skip_get_nested_data_buffer(void* cfg, void* nest_buffer, uint64_t nest_size, void* data_buffer, uint64_t data_size) {
-    SkipConfig* parent_config = (SkipConfig*)cfg;
-    uint64_t meta_size;
-    memcpy(&meta_size, nest_buffer, sizeof(uint64_t));
+    int ret = ensure_capacity(&config->allocator, (void**)&config->plan, &config->plan_capacity, sizeof(SkipFieldPlan), config->types_size);
+    if (ret != SKIP_SUCCESS) {
+        return ret;
+    }
 
-    if (skip_get_system_endian() != parent_config->endian) {
-        meta_size = swap_uint64(meta_size);
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        skip_build_field_plan(config, i, &config->plan[i]);
+    }
+    ret = skip_compute_fingerprint(config, &config->fingerprint);
+    if (ret != SKIP_SUCCESS) {
+        return ret;
     }
 
-    if (nest_size < meta_size + sizeof(uint64_t)) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    ret = skip_build_name_index(config);
+    if (ret != SKIP_SUCCESS) {
+        return ret;
     }
+    config->compiled = 1;
 
-    uint64_t actual_data_size = nest_size - meta_size - sizeof(uint64_t);
+    return SKIP_SUCCESS;
+}
 
-    if (actual_data_size > data_size) {
+int skip_is_config_compiled(void* cfg) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    return config->compiled;
+}
+
+int skip_write_index_to_buffer(void* cfg, void* buffer, uint64_t buffer_size, void* value, uint64_t index) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (index >= config->types_size) return SKIP_ERROR_OUT_OF_BOUNDS;
+
+    SkipFieldPlan scratch;
+    const SkipFieldPlan* field = skip_get_field_plan(config, index, &scratch);
+
+    if (field->offset + field->byte_len > buffer_size) {
         return SKIP_ERROR_BUFFER_TOO_SMALL;
     }
 
-    memcpy(data_buffer, (uint8_t*)nest_buffer + meta_size + sizeof(uint64_t), actual_data_size);
+    field->kernel((uint8_t*)buffer + field->offset, (const uint8_t*)value, field->byte_len);
 
     return SKIP_SUCCESS;
 }
 
-uint64_t skip_export_standalone_size(void* cfg) {
-    return skip_get_header_export_size() + skip_get_export_header_body_size(cfg) + skip_get_data_size(cfg);
-}
+// Shared body of skip_write_all/skip_read_all. All bounds are checked before
+// anything is copied, then every field goes through its kernel in one pass.
+static int skip_check_transfer(SkipConfig* config, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count) {
+    if (!config || !buffer || !fields) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
 
-int skip_export_standalone(void* cfg, void* data_buffer, uint64_t data_size, void* standalone_buffer, uint64_t standalone_size) {
-    uint64_t header_size = skip_get_header_export_size();
-    uint64_t header_body_size;
-    
-    int err = skip_export_header(cfg, standalone_buffer, header_size, &header_body_size);
-    if (err != SKIP_SUCCESS) {
-        return err;
+    if (field_count != config->types_size) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
     }
 
-    void* header_body_mem = malloc(header_body_size);
-    if (!header_body_mem) {
-        return SKIP_ERROR_ALLOCATION_FAILED;
+    if (skip_get_data_size(config) > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
     }
 
-    err = skip_export_header_body(cfg, header_body_mem, header_body_size);
-    if (err == SKIP_SUCCESS) {
-        memcpy((uint8_t*)standalone_buffer + header_size, header_body_mem, header_body_size);
-        memcpy((uint8_t*)standalone_buffer + header_size + header_body_size, data_buffer, data_size);
+    for (uint64_t i = 0; i < field_count; ++i) {
+        uint64_t byte_len = config->offsets[i + 1] - config->offsets[i];
+        if (fields[i].base && fields[i].len < byte_len) {
+            return SKIP_ERROR_BUFFER_TOO_SMALL;
+        }
     }
 
-    free(header_body_mem);
-    return err;
+    return SKIP_SUCCESS;
 }
 
-int skip_import_standalone_get_cfg(void** out_cfg, void* buffer, uint64_t buffer_size) {
-    uint64_t header_body_size;
-    *out_cfg = skip_import_header(buffer, buffer_size, &header_body_size , NULL);
-    if (!*out_cfg) {
-        return SKIP_ERROR_INVALID_CONFIG;
-    }
-
-    void* new_buffer = (uint8_t*)buffer + skip_get_header_export_size();
-    int err = skip_import_header_body(*out_cfg, new_buffer, header_body_size);
+static int skip_transfer_all(SkipConfig* config, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count, int to_buffer) {
+    int err = skip_check_transfer(config, buffer, buffer_size, fields, field_count);
     if (err != SKIP_SUCCESS) {
-        skip_free_cfg(*out_cfg);
-        *out_cfg = NULL;
         return err;
     }
 
+    uint8_t* base = (uint8_t*)buffer;
+    if (config->compiled) {
+        for (uint64_t i = 0; i < field_count; ++i) {
+            const SkipFieldPlan* field = &config->plan[i];
+            if (!fields[i].base) continue;
+            if (to_buffer) {
+                field->kernel(base + field->offset, (const uint8_t*)fields[i].base, field->byte_len);
+            } else {
+                field->kernel((uint8_t*)fields[i].base, base + field->offset, field->byte_len);
+            }
+        }
+        return SKIP_SUCCESS;
+    }
+
+    int swap = skip_get_system_endian() != config->endian;
+    int simd_level = skip_get_simd_level();
+    for (uint64_t i = 0; i < field_count; ++i) {
+        if (!fields[i].base) continue;
+
+        uint64_t offset = config->offsets[i];
+        uint64_t byte_len = config->offsets[i + 1] - offset;
+        uint64_t type_size = skip_get_swap_unit(config->types[i].type_code);
+        SkipSwapKernel kernel = swap ? skip_select_swap_kernel(type_size, simd_level) : skip_copy_kernel;
+
+        if (to_buffer) {
+            kernel(base + offset, (const uint8_t*)fields[i].base, byte_len);
+        } else {
+            kernel((uint8_t*)fields[i].base, base + offset, byte_len);
+        }
+    }
+
     return SKIP_SUCCESS;
 }
 
+int skip_write_all(void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count) {
+    return skip_transfer_all((SkipConfig*)cfg, buffer, buffer_size, fields, field_count, 1);
+}
 
-int skip_import_standalone_get_data_buffer(void* cfg , void* buffer , uint64_t buffer_size , void* data_buffer , uint64_t data_buffer_size) {
-    uint64_t header_size = skip_get_header_export_size();
-    uint64_t header_body_size = skip_get_export_header_body_size(cfg);
-    uint64_t body_size = skip_get_data_size(cfg);
-    
-    if (body_size > data_buffer_size) {
-        return SKIP_ERROR_BUFFER_TOO_SMALL;
+int skip_read_all(void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count) {
+    return skip_transfer_all((SkipConfig*)cfg, buffer, buffer_size, fields, field_count, 0);
+}
+
+typedef struct {
+    uint64_t buffer_offset;
+    uint64_t struct_offset;
+    uint64_t byte_len;
+    SkipSwapKernel kernel;
+} SkipStructOp;
+
+typedef struct {
+    SkipStructOp* ops;
+    uint64_t ops_size;
+    uint64_t record_size;
+    uint64_t struct_size;
+    SkipAllocator allocator;
+} SkipStructMap;
+
+void* skip_create_struct_map(void* cfg, const SkipStructMember* members, uint64_t member_count, uint64_t struct_size) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || (!members && member_count > 0) || struct_size == 0) {
+        return NULL;
     }
 
-    void* new_buffer = (uint8_t*) buffer + header_size + header_body_size;
+    SkipAllocator allocator = skip_global_allocator;
+    SkipStructMap* map = (SkipStructMap*)skip_mem_alloc(&allocator, sizeof(SkipStructMap));
+    if (!map) return NULL;
+    map->allocator = allocator;
 
-    memcpy(data_buffer, new_buffer, body_size);
+    map->ops = (SkipStructOp*)skip_mem_alloc(&allocator, (member_count ? member_count : 1) * sizeof(SkipStructOp));
+    if (!map->ops) {
+        skip_mem_free(&allocator, map, sizeof(SkipStructMap));
+        return NULL;
+    }
+    map->ops_size = member_count;
+    map->record_size = skip_get_data_size(config);
+    map->struct_size = struct_size;
+
+    for (uint64_t i = 0; i < member_count; ++i) {
+        if (members[i].index >= config->types_size) {
+            skip_free_struct_map(map);
+            return NULL;
+        }
 
-    return SKIP_SUCCESS;
+        SkipFieldPlan field;
+        skip_build_field_plan(config, members[i].index, &field);
+        if (members[i].offset + field.byte_len > struct_size) {
+            skip_free_struct_map(map);
+            return NULL;
+        }
+
+        map->ops[i].buffer_offset = field.offset;
+        map->ops[i].struct_offset = members[i].offset;
+        map->ops[i].byte_len = field.byte_len;
+        map->ops[i].kernel = field.kernel;
+    }
+
+    return map;
+}
+
+int skip_free_struct_map(void* map) {
+    if (map) {
+        SkipStructMap* struct_map = (SkipStructMap*)map;
+        SkipAllocator allocator = struct_map->allocator;
+        skip_mem_free(&allocator, struct_map->ops, (struct_map->ops_size ? struct_map->ops_size : 1) * sizeof(SkipStructOp));
+        skip_mem_free(&allocator, struct_map, sizeof(SkipStructMap));
+    }
+    return SKIP_SUCCESS;
+}
+
+uint64_t skip_get_struct_map_record_size(void* map) {
+    SkipStructMap* struct_map = (SkipStructMap*)map;
+    return struct_map->record_size;
+}
+
+int skip_struct_read(void* map, void* buffer, uint64_t buffer_size, void* structs, uint64_t struct_count) {
+    SkipStructMap* struct_map = (SkipStructMap*)map;
+    if (!struct_map || !buffer || (!structs && struct_count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (struct_count > 0 && struct_map->record_size > buffer_size / struct_count) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const uint8_t* record = (const uint8_t*)buffer;
+    uint8_t* out = (uint8_t*)structs;
+    for (uint64_t r = 0; r < struct_count; ++r) {
+        for (uint64_t i = 0; i < struct_map->ops_size; ++i) {
+            const SkipStructOp* op = &struct_map->ops[i];
+            op->kernel(out + op->struct_offset, record + op->buffer_offset, op->byte_len);
+        }
+        record += struct_map->record_size;
+        out += struct_map->struct_size;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+int skip_struct_write(void* map, void* buffer, uint64_t buffer_size, const void* structs, uint64_t struct_count) {
+    SkipStructMap* struct_map = (SkipStructMap*)map;
+    if (!struct_map || !buffer || (!structs && struct_count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (struct_count > 0 && struct_map->record_size > buffer_size / struct_count) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* record = (uint8_t*)buffer;
+    const uint8_t* in = (const uint8_t*)structs;
+    for (uint64_t r = 0; r < struct_count; ++r) {
+        for (uint64_t i = 0; i < struct_map->ops_size; ++i) {
+            const SkipStructOp* op = &struct_map->ops[i];
+            op->kernel(record + op->buffer_offset, in + op->struct_offset, op->byte_len);
+        }
+        record += struct_map->record_size;
+        in += struct_map->struct_size;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+// A projection maps messages of a writer schema onto a reader schema. Each
+// reader field either comes from the writer field with the same name (or,
+// for unnamed fields, the same position) or is filled with its default;
+// writer fields the reader does not know are skipped. The ops are built once
+// in reader order, adjacent copies are merged, and skip_project then makes
+// a single pass over the output.
+#define SKIP_PROJECTION_MAX_FILL 16
+
+typedef struct {
+    uint64_t dst_offset;
+    uint64_t src_offset;
+    uint64_t byte_len;
+    SkipSwapKernel kernel;
+    uint64_t reader_index;
+    uint64_t fill_size;
+    uint8_t fill[SKIP_PROJECTION_MAX_FILL];
+} SkipProjectionOp;
+
+typedef struct {
+    SkipProjectionOp* ops;
+    uint64_t ops_size;
+    uint64_t ops_capacity;
+    int64_t* sources;
+    uint64_t reader_count;
+    uint64_t writer_size;
+    uint64_t reader_size;
+    int reader_endian;
+    int copy_heap;
+    SkipAllocator allocator;
+} SkipProjection;
+
+static SkipProjectionOp* skip_projection_add_op(SkipProjection* projection) {
+    if (projection->ops_size == projection->ops_capacity) {
+        uint64_t new_cap = projection->ops_capacity ? projection->ops_capacity * 2 : 8;
+        SkipProjectionOp* ops = (SkipProjectionOp*)skip_mem_alloc(&projection->allocator, new_cap * sizeof(SkipProjectionOp));
+        if (!ops) {
+            return NULL;
+        }
+        if (projection->ops) {
+            memcpy(ops, projection->ops, projection->ops_size * sizeof(SkipProjectionOp));
+            skip_mem_free(&projection->allocator, projection->ops, projection->ops_capacity * sizeof(SkipProjectionOp));
+        }
+        projection->ops = ops;
+        projection->ops_capacity = new_cap;
+    }
+
+    SkipProjectionOp* op = &projection->ops[projection->ops_size++];
+    memset(op, 0, sizeof(SkipProjectionOp));
+    return op;
+}
+
+static int64_t skip_projection_find_source(SkipConfig* writer, SkipConfig* reader, uint64_t index) {
+    if (index < reader->field_names_size && reader->field_names[index].length > 0) {
+        const SkipFieldName* name = &reader->field_names[index];
+        return skip_field_index_n(writer, reader->names + name->offset, name->length);
+    }
+    if (index < writer->types_size && (index >= writer->field_names_size || writer->field_names[index].length == 0)) {
+        return (int64_t)index;
+    }
+    return SKIP_ERROR_UNKNOWN_FIELD;
+}
+
+int skip_create_projection(void** out_projection, void* writer_cfg, void* reader_cfg) {
+    SkipConfig* writer = (SkipConfig*)writer_cfg;
+    SkipConfig* reader = (SkipConfig*)reader_cfg;
+    if (!out_projection || !writer || !reader) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    *out_projection = NULL;
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipProjection* projection = (SkipProjection*)skip_mem_alloc(&allocator, sizeof(SkipProjection));
+    if (!projection) {
+        return SKIP_ERROR_ALLOCATION_FAILED;
+    }
+    memset(projection, 0, sizeof(SkipProjection));
+    projection->allocator = allocator;
+    projection->reader_count = reader->types_size;
+    projection->writer_size = skip_get_data_size(writer);
+    projection->reader_size = skip_get_data_size(reader);
+    projection->reader_endian = reader->endian;
+
+    projection->sources = (int64_t*)skip_mem_alloc(&allocator, (reader->types_size ? reader->types_size : 1) * sizeof(int64_t));
+    if (!projection->sources) {
+        skip_free_projection(projection);
+        return SKIP_ERROR_ALLOCATION_FAILED;
+    }
+
+    int swap = writer->endian != reader->endian;
+    int simd_level = skip_get_simd_level();
+    for (uint64_t i = 0; i < reader->types_size; ++i) {
+        int32_t type_code = reader->types[i].type_code;
+        uint64_t unit = skip_get_swap_unit(type_code);
+        uint64_t element_size = skip_get_datatype_size(type_code);
+        uint64_t dst_offset = reader->offsets[i];
+        uint64_t dst_len = reader->offsets[i + 1] - dst_offset;
+        uint64_t copied = 0;
+
+        int64_t source = skip_projection_find_source(writer, reader, i);
+        projection->sources[i] = source;
+        if (skip_get_var_element_size(type_code)) {
+            projection->copy_heap = 1;
+        }
+
+        if (source >= 0) {
+            if (writer->types[source].type_code != type_code) {
+                skip_free_projection(projection);
+                return SKIP_ERROR_INVALID_CONFIG;
+            }
+            // Heap arrays are copied verbatim, so their elements cannot be
+            // converted to another byte order.
+            if (swap && (type_code & skip_array) && skip_get_var_element_size(type_code) > 1) {
+                skip_free_projection(projection);
+                return SKIP_ERROR_INVALID_CONFIG;
+            }
+
+            uint64_t count = writer->types[source].count < reader->types[i].count ? writer->types[source].count : reader->types[i].count;
+            copied = count * element_size;
+            SkipSwapKernel kernel = swap && unit > 1 ? skip_select_swap_kernel(unit, simd_level) : skip_copy_kernel;
+            uint64_t src_offset = writer->offsets[source];
+
+            SkipProjectionOp* prev = projection->ops_size ? &projection->ops[projection->ops_size - 1] : NULL;
+            if (copied == 0) {
+                // Nothing to copy; the remainder below covers the field.
+            } else if (prev && prev->kernel == kernel && prev->src_offset + prev->byte_len == src_offset &&
+                       prev->dst_offset + prev->byte_len == dst_offset) {
+                prev->byte_len += copied;
+            } else {
+                SkipProjectionOp* op = skip_projection_add_op(projection);
+                if (!op) {
+                    skip_free_projection(projection);
+                    return SKIP_ERROR_ALLOCATION_FAILED;
+                }
+                op->dst_offset = dst_offset;
+                op->src_offset = src_offset;
+                op->byte_len = copied;
+                op->kernel = kernel;
+                op->reader_index = i;
+            }
+        }
+
+        if (copied < dst_len) {
+            SkipProjectionOp* op = skip_projection_add_op(projection);
+            if (!op) {
+                skip_free_projection(projection);
+                return SKIP_ERROR_ALLOCATION_FAILED;
+            }
+            op->dst_offset = dst_offset + copied;
+            op->byte_len = dst_len - copied;
+            op->reader_index = i;
+            op->fill_size = element_size;
+        }
+    }
+
+    *out_projection = projection;
+    return SKIP_SUCCESS;
+}
+
+int skip_free_projection(void* projection) {
+    if (projection) {
+        SkipProjection* p = (SkipProjection*)projection;
+        SkipAllocator allocator = p->allocator;
+        skip_mem_free(&allocator, p->ops, p->ops_capacity * sizeof(SkipProjectionOp));
+        skip_mem_free(&allocator, p->sources, (p->reader_count ? p->reader_count : 1) * sizeof(int64_t));
+        skip_mem_free(&allocator, p, sizeof(SkipProjection));
+    }
+    return SKIP_SUCCESS;
+}
+
+int64_t skip_get_projection_source(void* projection, uint64_t reader_index) {
+    SkipProjection* p = (SkipProjection*)projection;
+    if (!p || reader_index >= p->reader_count) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+    return p->sources[reader_index];
+}
+
+int skip_set_projection_default(void* projection, uint64_t reader_index, const void* value) {
+    SkipProjection* p = (SkipProjection*)projection;
+    if (!p || !value) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (reader_index >= p->reader_count) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    for (uint64_t i = 0; i < p->ops_size; ++i) {
+        SkipProjectionOp* op = &p->ops[i];
+        if (op->kernel || op->reader_index != reader_index) {
+            continue;
+        }
+        // Slots of variable-length fields always default to empty.
+        if (op->fill_size == SKIP_VAR_SLOT_SIZE) {
+            return SKIP_ERROR_INVALID_ARGUMENT;
+        }
+        if (op->fill_size > 1 && p->reader_endian != skip_get_system_endian()) {
+            skip_select_swap_kernel(op->fill_size, SKIP_SIMD_SCALAR)(op->fill, (const uint8_t*)value, op->fill_size);
+        } else {
+            memcpy(op->fill, value, op->fill_size);
+        }
+    }
+    return SKIP_SUCCESS;
+}
+
+uint64_t skip_get_projected_size(void* projection, uint64_t src_size) {
+    SkipProjection* p = (SkipProjection*)projection;
+    if (!p || src_size < p->writer_size) {
+        return 0;
+    }
+    return p->reader_size + (p->copy_heap ? src_size - p->writer_size : 0);
+}
+
+static void skip_projection_fill(uint8_t* dst, uint64_t bytes, const uint8_t* pattern, uint64_t pattern_size) {
+    uint64_t zero = 1;
+    for (uint64_t i = 0; i < pattern_size; ++i) {
+        zero &= pattern[i] == 0;
+    }
+    if (zero || pattern_size == 1) {
+        memset(dst, pattern[0], bytes);
+        return;
+    }
+
+    // Write one element, then double the filled prefix.
+    memcpy(dst, pattern, pattern_size);
+    uint64_t filled = pattern_size;
+    while (filled < bytes) {
+        uint64_t n = filled < bytes - filled ? filled : bytes - filled;
+        memcpy(dst + filled, dst, n);
+        filled += n;
+    }
+}
+
+int skip_project(void* projection, const void* src, uint64_t src_size, void* dst, uint64_t dst_size) {
+    SkipProjection* p = (SkipProjection*)projection;
+    if (!p || !src || !dst) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (src_size < p->writer_size || dst_size < skip_get_projected_size(p, src_size)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const uint8_t* in = (const uint8_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    for (uint64_t i = 0; i < p->ops_size; ++i) {
+        const SkipProjectionOp* op = &p->ops[i];
+        if (op->kernel) {
+            op->kernel(out + op->dst_offset, in + op->src_offset, op->byte_len);
+        } else {
+            skip_projection_fill(out + op->dst_offset, op->byte_len, op->fill, op->fill_size);
+        }
+    }
+
+    // Heap offsets are relative to the heap, so the writer's heap stays
+    // valid when moved behind the reader's fixed fields.
+    if (p->copy_heap) {
+        memcpy(out + p->reader_size, in + p->writer_size, src_size - p->writer_size);
+    }
+
+    return SKIP_SUCCESS;
+}
+
+#define SKIP_RECORD_COUNT_SIZE sizeof(uint64_t)
+#define SKIP_RECORD_BLOCK 256
+
+uint64_t skip_get_record_array_size(void* cfg, uint64_t record_count) {
+    return SKIP_RECORD_COUNT_SIZE + record_count * skip_get_data_size(cfg);
+}
+
+int skip_init_record_array(void* cfg, void* buffer, uint64_t buffer_size, uint64_t record_count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (buffer_size < skip_get_record_array_size(cfg, record_count)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t count_to_write = record_count;
+    if (skip_get_system_endian() != config->endian) {
+        count_to_write = swap_uint64(count_to_write);
+    }
+    memcpy(buffer, &count_to_write, SKIP_RECORD_COUNT_SIZE);
+
+    return SKIP_SUCCESS;
+}
+
+int skip_get_record_array_count(void* cfg, void* buffer, uint64_t buffer_size, uint64_t* out_count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || !out_count) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (buffer_size < SKIP_RECORD_COUNT_SIZE) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t record_count;
+    memcpy(&record_count, buffer, SKIP_RECORD_COUNT_SIZE);
+    if (skip_get_system_endian() != config->endian) {
+        record_count = swap_uint64(record_count);
+    }
+
+    uint64_t stride = skip_get_data_size(cfg);
+    if (stride > 0 && record_count > (buffer_size - SKIP_RECORD_COUNT_SIZE) / stride) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *out_count = record_count;
+    return SKIP_SUCCESS;
+}
+
+void* skip_get_record_ptr(void* cfg, void* buffer, uint64_t buffer_size, uint64_t record_index) {
+    uint64_t record_count;
+    if (skip_get_record_array_count(cfg, buffer, buffer_size, &record_count) != SKIP_SUCCESS) {
+        return NULL;
+    }
+
+    if (record_index >= record_count || ((SkipConfig*)cfg)->layout != SKIP_LAYOUT_ROWS) {
+        return NULL;
+    }
+
+    return (uint8_t*)buffer + SKIP_RECORD_COUNT_SIZE + record_index * skip_get_data_size(cfg);
+}
+
+// Converts count packed records between host order and wire order. Adjacent
+// fields with the same element size are merged into one run, so a record of
+// all int32 fields is a single kernel call over the whole range.
+static void skip_transfer_records(SkipConfig* config, uint8_t* dst, const uint8_t* src, uint64_t count) {
+    uint64_t stride = skip_get_data_size(config);
+
+    if (skip_get_system_endian() == config->endian) {
+        skip_copy_kernel(dst, src, stride * count);
+        return;
+    }
+
+    int simd_level = skip_get_simd_level();
+    for (uint64_t block = 0; block < count; block += SKIP_RECORD_BLOCK) {
+        uint64_t block_count = count - block < SKIP_RECORD_BLOCK ? count - block : SKIP_RECORD_BLOCK;
+        uint8_t* block_dst = dst + block * stride;
+        const uint8_t* block_src = src + block * stride;
+
+        uint64_t i = 0;
+        while (i < config->types_size) {
+            uint64_t type_size = skip_get_swap_unit(config->types[i].type_code);
+            uint64_t run_start = config->offsets[i];
+            uint64_t j = i + 1;
+            while (j < config->types_size && skip_get_swap_unit(config->types[j].type_code) == type_size) {
+                ++j;
+            }
+            uint64_t run_len = config->offsets[j] - run_start;
+            SkipSwapKernel kernel = type_size == 1 ? skip_copy_kernel : skip_select_swap_kernel(type_size, simd_level);
+
+            if (run_len == stride) {
+                kernel(block_dst, block_src, stride * block_count);
+            } else {
+                for (uint64_t r = 0; r < block_count; ++r) {
+                    kernel(block_dst + r * stride + run_start, block_src + r * stride + run_start, run_len);
+                }
+            }
+            i = j;
+        }
+    }
+}
+
+// In the columnar layout field k of all N records is stored contiguously,
+// and since every earlier column holds N elements of its field the column
+// starts at N * offsets[k] past the record count.
+static uint8_t* skip_column_start(SkipConfig* config, void* buffer, uint64_t record_count, uint64_t index) {
+    return (uint8_t*)buffer + SKIP_RECORD_COUNT_SIZE + record_count * config->offsets[index];
+}
+
+static void skip_write_columns(SkipConfig* config, void* buffer, uint64_t record_count, const uint8_t* records, uint64_t first, uint64_t count) {
+    uint64_t stride = skip_get_data_size(config);
+
+    for (uint64_t k = 0; k < config->types_size; ++k) {
+        SkipFieldPlan field;
+        skip_build_field_plan(config, k, &field);
+
+        uint8_t* column = skip_column_start(config, buffer, record_count, k) + first * field.byte_len;
+        for (uint64_t r = 0; r < count; ++r) {
+            memcpy(column + r * field.byte_len, records + r * stride + field.offset, (size_t)field.byte_len);
+        }
+        field.kernel(column, column, field.byte_len * count);
+    }
+}
+
+static void skip_read_columns(SkipConfig* config, void* buffer, uint64_t record_count, uint8_t* records, uint64_t first, uint64_t count) {
+    uint64_t stride = skip_get_data_size(config);
+    uint8_t scratch[4096];
+
+    for (uint64_t k = 0; k < config->types_size; ++k) {
+        SkipFieldPlan field;
+        skip_build_field_plan(config, k, &field);
+        if (field.byte_len == 0) continue;
+
+        const uint8_t* column = skip_column_start(config, buffer, record_count, k) + first * field.byte_len;
+        uint64_t chunk = sizeof(scratch) / field.byte_len;
+        if (chunk == 0) {
+            for (uint64_t r = 0; r < count; ++r) {
+                field.kernel(records + r * stride + field.offset, column + r * field.byte_len, field.byte_len);
+            }
+            continue;
+        }
+
+        // Swap a chunk of the column with one kernel call, then scatter it.
+        for (uint64_t r = 0; r < count; r += chunk) {
+            uint64_t n = count - r < chunk ? count - r : chunk;
+            field.kernel(scratch, column + r * field.byte_len, n * field.byte_len);
+            for (uint64_t e = 0; e < n; ++e) {
+                memcpy(records + (r + e) * stride + field.offset, scratch + e * field.byte_len, (size_t)field.byte_len);
+            }
+        }
+    }
+}
+
+void* skip_get_column_ptr(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || config->layout != SKIP_LAYOUT_COLUMNS || index >= config->types_size) {
+        return NULL;
+    }
+
+    uint64_t record_count;
+    if (skip_get_record_array_count(cfg, buffer, buffer_size, &record_count) != SKIP_SUCCESS) {
+        return NULL;
+    }
+
+    return skip_column_start(config, buffer, record_count, index);
+}
+
+int skip_write_records(void* cfg, void* buffer, uint64_t buffer_size, const void* records, uint64_t first, uint64_t count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || (!records && count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t record_count;
+    int err = skip_get_record_array_count(cfg, buffer, buffer_size, &record_count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    if (first > record_count || count > record_count - first) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    if (config->layout == SKIP_LAYOUT_COLUMNS) {
+        skip_write_columns(config, buffer, record_count, (const uint8_t*)records, first, count);
+        return SKIP_SUCCESS;
+    }
+
+    uint8_t* dst = (uint8_t*)buffer + SKIP_RECORD_COUNT_SIZE + first * skip_get_data_size(cfg);
+    skip_transfer_records(config, dst, (const uint8_t*)records, count);
+
+    return SKIP_SUCCESS;
+}
+
+int skip_read_records(void* cfg, void* buffer, uint64_t buffer_size, void* records, uint64_t first, uint64_t count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || (!records && count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t record_count;
+    int err = skip_get_record_array_count(cfg, buffer, buffer_size, &record_count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    if (first > record_count || count > record_count - first) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    if (config->layout == SKIP_LAYOUT_COLUMNS) {
+        skip_read_columns(config, buffer, record_count, (uint8_t*)records, first, count);
+        return SKIP_SUCCESS;
+    }
+
+    const uint8_t* src = (const uint8_t*)buffer + SKIP_RECORD_COUNT_SIZE + first * skip_get_data_size(cfg);
+    skip_transfer_records(config, (uint8_t*)records, src, count);
+
+    return SKIP_SUCCESS;
+}
+
+int skip_read_record_column(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t first, uint64_t count, void* out) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || (!out && count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (index >= config->types_size) return SKIP_ERROR_OUT_OF_BOUNDS;
+
+    uint64_t record_count;
+    int err = skip_get_record_array_count(cfg, buffer, buffer_size, &record_count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    if (first > record_count || count > record_count - first) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    SkipFieldPlan field;
+    skip_build_field_plan(config, index, &field);
+
+    if (config->layout == SKIP_LAYOUT_COLUMNS) {
+        const uint8_t* column = skip_column_start(config, buffer, record_count, index) + first * field.byte_len;
+        field.kernel((uint8_t*)out, column, field.byte_len * count);
+        return SKIP_SUCCESS;
+    }
+
+    uint64_t stride = skip_get_data_size(cfg);
+    const uint8_t* src = (const uint8_t*)buffer + SKIP_RECORD_COUNT_SIZE + first * stride + field.offset;
+    uint8_t* dst = (uint8_t*)out;
+
+    // Gather the strided values first, then swap the contiguous result in
+    // one vectorized pass.
+    switch (field.byte_len) {
+        case 1:
+            for (uint64_t r = 0; r < count; ++r) dst[r] = src[r * stride];
+            break;
+        case 2:
+            for (uint64_t r = 0; r < count; ++r) memcpy(dst + r * 2, src + r * stride, 2);
+            break;
+        case 4:
+            for (uint64_t r = 0; r < count; ++r) memcpy(dst + r * 4, src + r * stride, 4);
+            break;
+        case 8:
+            for (uint64_t r = 0; r < count; ++r) memcpy(dst + r * 8, src + r * stride, 8);
+            break;
+        default:
+            for (uint64_t r = 0; r < count; ++r) memcpy(dst + r * field.byte_len, src + r * stride, (size_t)field.byte_len);
+            break;
+    }
+
+    field.kernel(dst, dst, field.byte_len * count);
+
+    return SKIP_SUCCESS;
+}
+
+// The compact table starts with a marker byte that no fixed table can start
+// with: valid type codes are small and non-negative in either byte order.
+// It is followed by runs of three LEB128 varints: type code, count, and
+// the number of consecutive entries with that type and count.
+#define SKIP_COMPACT_BODY_MARKER 0xFF
+// A body carrying field names starts with this marker, the size of the
+// type table as a varint, the table itself in either format, and then one
+// varint length plus the name bytes per field (length 0 for no name).
+// Configs without names export exactly as before.
+#define SKIP_NAMED_BODY_MARKER 0xFE
+#define SKIP_VARINT_MAX_SIZE 10
+#define SKIP_COMPACT_MAX_RUN (5 + 2 * SKIP_VARINT_MAX_SIZE)
+// A compact run of a few bytes can declare any number of fields, so
+// imported tables are capped before anything is allocated for them.
+#ifndef SKIP_MAX_IMPORT_FIELDS
+#define SKIP_MAX_IMPORT_FIELDS (1u << 20)
+#endif
+
+static uint64_t skip_varint_size(uint64_t value) {
+    uint64_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static uint64_t skip_put_varint(uint8_t* out, uint64_t value) {
+    uint64_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = (uint8_t)value;
+    return size;
+}
+
+static int skip_get_varint(const uint8_t** pos, const uint8_t* end, uint64_t* out) {
+    uint64_t value = 0;
+    const uint8_t* p = *pos;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = *p++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *pos = p;
+            *out = value;
+            return SKIP_SUCCESS;
+        }
+    }
+    return SKIP_ERROR_INVALID_CONFIG;
+}
+
+static uint64_t skip_compact_run_length(SkipConfig* config, uint64_t first) {
+    uint64_t last = first + 1;
+    while (last < config->types_size &&
+           config->types[last].type_code == config->types[first].type_code &&
+           config->types[last].count == config->types[first].count) {
+        last++;
+    }
+    return last - first;
+}
+
+static uint64_t skip_encode_compact_run(SkipConfig* config, uint64_t first, uint64_t run, uint8_t* out) {
+    uint64_t size = skip_put_varint(out, (uint32_t)config->types[first].type_code);
+    size += skip_put_varint(out + size, config->types[first].count);
+    size += skip_put_varint(out + size, run);
+    return size;
+}
+
+static uint64_t skip_get_table_size(SkipConfig* config) {
+    if (config->header_format != SKIP_HEADER_FORMAT_COMPACT) {
+        return config->types_size * SKIP_HEADER_ENTRY_SIZE;
+    }
+
+    uint64_t size = 1;
+    for (uint64_t i = 0; i < config->types_size;) {
+        uint64_t run = skip_compact_run_length(config, i);
+        size += skip_varint_size((uint32_t)config->types[i].type_code) + skip_varint_size(config->types[i].count) + skip_varint_size(run);
+        i += run;
+    }
+    return size;
+}
+
+static uint64_t skip_get_names_size(SkipConfig* config) {
+    uint64_t size = 0;
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        uint64_t length = i < config->field_names_size ? config->field_names[i].length : 0;
+        size += skip_varint_size(length) + length;
+    }
+    return size;
+}
+
+uint64_t skip_get_export_header_body_size(void* cfg) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    uint64_t table_size = skip_get_table_size(config);
+    if (config->named_count == 0) {
+        return table_size;
+    }
+    return 1 + skip_varint_size(table_size) + table_size + skip_get_names_size(config);
+}
+
+static void skip_export_header_entries(SkipConfig* config, uint64_t first, uint64_t count, char* buffer) {
+    char* current_pos = buffer;
+    for (uint64_t i = first; i < first + count; ++i) {
+        int32_t type_code = config->types[i].type_code;
+        uint64_t type_count = config->types[i].count;
+
+        if (skip_get_system_endian() != config->endian) {
+            type_code = swap_uint32(type_code);
+            type_count = swap_uint64(type_count);
+        }
+
+        memcpy(current_pos, &type_code, sizeof(int32_t));
+        current_pos += sizeof(int32_t);
+        memcpy(current_pos, &type_count, sizeof(uint64_t));
+        current_pos += sizeof(uint64_t);
+    }
+}
+
+static uint8_t* skip_export_table(SkipConfig* config, uint8_t* pos) {
+    if (config->header_format != SKIP_HEADER_FORMAT_COMPACT) {
+        skip_export_header_entries(config, 0, config->types_size, (char*)pos);
+        return pos + config->types_size * SKIP_HEADER_ENTRY_SIZE;
+    }
+
+    *pos++ = SKIP_COMPACT_BODY_MARKER;
+    for (uint64_t i = 0; i < config->types_size;) {
+        uint64_t run = skip_compact_run_length(config, i);
+        pos += skip_encode_compact_run(config, i, run, pos);
+        i += run;
+    }
+    return pos;
+}
+
+int skip_export_header_body(void* cfg, char* buffer, uint64_t buffer_size) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    uint64_t required_size = skip_get_export_header_body_size(cfg);
+    if (buffer_size < required_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* pos = (uint8_t*)buffer;
+    if (config->named_count == 0) {
+        skip_export_table(config, pos);
+        return SKIP_SUCCESS;
+    }
+
+    *pos++ = SKIP_NAMED_BODY_MARKER;
+    pos += skip_put_varint(pos, skip_get_table_size(config));
+    pos = skip_export_table(config, pos);
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        uint64_t length = i < config->field_names_size ? config->field_names[i].length : 0;
+        pos += skip_put_varint(pos, length);
+        if (length > 0) {
+            memcpy(pos, config->names + config->field_names[i].offset, length);
+            pos += length;
+        }
+    }
+
+    return SKIP_SUCCESS;
+}
+
+// Appends a whole run at once: capacity is reserved once and the datatype
+// size is looked up once per run instead of once per entry.
+static int skip_push_compact_run(SkipConfig* config, uint64_t type_code, uint64_t count, uint64_t run) {
+    if (type_code > INT32_MAX || run == 0 || config->types_size > SKIP_MAX_IMPORT_FIELDS ||
+        run > SKIP_MAX_IMPORT_FIELDS - config->types_size) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
+
+    uint64_t needed = config->types_size + run;
+    if (needed > config->types_capacity) {
+        uint64_t new_cap = config->types_capacity * 2 > needed ? config->types_capacity * 2 : needed;
+        if (ensure_capacity(&config->allocator, (void**)&config->types, &config->types_capacity, sizeof(SkipInternalType), new_cap) != SKIP_SUCCESS) {
+            return SKIP_ERROR_ALLOCATION_FAILED;
+        }
+    }
+    if (config->offsets_size + run > config->offsets_capacity) {
+        uint64_t new_cap = config->offsets_capacity * 2 > config->offsets_size + run ? config->offsets_capacity * 2 : config->offsets_size + run;
+        if (ensure_capacity(&config->allocator, (void**)&config->offsets, &config->offsets_capacity, sizeof(uint64_t), new_cap) != SKIP_SUCCESS) {
+            return SKIP_ERROR_ALLOCATION_FAILED;
+        }
+    }
+
+    uint64_t field_size = skip_get_datatype_size((int32_t)type_code) * count;
+    uint64_t offset = config->offsets[config->offsets_size - 1];
+    for (uint64_t r = 0; r < run; ++r) {
+        config->types[config->types_size].type_code = (int32_t)type_code;
+        config->types[config->types_size].count = count;
+        config->types_size++;
+
+        offset += field_size;
+        config->offsets[config->offsets_size++] = offset;
+    }
+    config->compiled = 0;
+
+    return SKIP_SUCCESS;
+}
+
+static int skip_import_compact_body(SkipConfig* config, const uint8_t* pos, const uint8_t* end) {
+    while (pos < end) {
+#if defined(SKIP_HAVE_X86_SIMD) && defined(__SSE2__)
+        // Most runs are three one-byte varints. Find how many leading bytes
+        // have no continuation bit and decode those runs without branching
+        // on every byte.
+        if (end - pos >= 16) {
+            __m128i bytes = _mm_loadu_si128((const __m128i*)pos);
+            uint32_t continuation = (uint32_t)_mm_movemask_epi8(bytes);
+            uint32_t single = (uint32_t)__builtin_ctz(continuation | 0x10000);
+            uint32_t runs = single / 3;
+            for (uint32_t r = 0; r < runs; ++r) {
+                int err = skip_push_compact_run(config, pos[0], pos[1], pos[2]);
+                if (err != SKIP_SUCCESS) {
+                    return err;
+                }
+                pos += 3;
+            }
+            if (runs > 0) {
+                continue;
+            }
+        }
+#endif
+        uint64_t type_code, count, run;
+        if (skip_get_varint(&pos, end, &type_code) != SKIP_SUCCESS ||
+            skip_get_varint(&pos, end, &count) != SKIP_SUCCESS ||
+            skip_get_varint(&pos, end, &run) != SKIP_SUCCESS) {
+            return SKIP_ERROR_INVALID_CONFIG;
+        }
+        int err = skip_push_compact_run(config, type_code, count, run);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
+    }
+    return SKIP_SUCCESS;
+}
+
+static int skip_import_named_body(SkipConfig* config, const uint8_t* pos, const uint8_t* end) {
+    uint64_t table_size;
+    if (skip_get_varint(&pos, end, &table_size) != SKIP_SUCCESS || table_size > (uint64_t)(end - pos) ||
+        (table_size > 0 && pos[0] == SKIP_NAMED_BODY_MARKER)) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+
+    uint64_t first = config->types_size;
+    int err = skip_import_header_body(config, (const char*)pos, table_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    pos += table_size;
+
+    for (uint64_t i = first; i < config->types_size; ++i) {
+        uint64_t length;
+        if (skip_get_varint(&pos, end, &length) != SKIP_SUCCESS || length > (uint64_t)(end - pos)) {
+            return SKIP_ERROR_INVALID_CONFIG;
+        }
+        if (length > 0 && skip_store_field_name(config, i, (const char*)pos, length) != SKIP_SUCCESS) {
+            return SKIP_ERROR_INVALID_CONFIG;
+        }
+        pos += length;
+    }
+
+    return pos == end ? SKIP_SUCCESS : SKIP_ERROR_INVALID_CONFIG;
+}
+
+int skip_import_header_body(void* cfg, const char* buffer, uint64_t buffer_size) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (config->shared) {
+        return SKIP_ERROR_CONFIG_IMMUTABLE;
+    }
+
+    if (buffer_size > 0 && (uint8_t)buffer[0] == SKIP_NAMED_BODY_MARKER) {
+        return skip_import_named_body(config, (const uint8_t*)buffer + 1, (const uint8_t*)buffer + buffer_size);
+    }
+
+    if (buffer_size > 0 && (uint8_t)buffer[0] == SKIP_COMPACT_BODY_MARKER) {
+        int err = skip_import_compact_body(config, (const uint8_t*)buffer + 1, (const uint8_t*)buffer + buffer_size);
+        if (err == SKIP_SUCCESS) {
+            config->header_format = SKIP_HEADER_FORMAT_COMPACT;
+        }
+        return err;
+    }
+
+    const char* current_pos = buffer;
+    const char* end_pos = buffer + buffer_size;
+    
+    if (buffer_size % SKIP_HEADER_ENTRY_SIZE != 0) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    
+    int system_endian = skip_get_system_endian();
+    int config_endian = config->endian;
+
+    while (current_pos < end_pos) {
+        int32_t type_code;
+        uint64_t count;
+
+        memcpy(&type_code, current_pos, sizeof(int32_t));
+        current_pos += sizeof(int32_t);
+        memcpy(&count, current_pos, sizeof(uint64_t));
+        current_pos += sizeof(uint64_t);
+
+        if (system_endian != config_endian) {
+            type_code = swap_uint32(type_code);
+            count = swap_uint64(count);
+        }
+
+        if (skip_push_type_to_config(cfg, type_code, count) != SKIP_SUCCESS) {
+            return SKIP_ERROR_INVALID_CONFIG;
+        }
+    }
+
+    return SKIP_SUCCESS;
+}
+
+void* skip_get_index_ptr(void* cfg, void* buffer, uint64_t index) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (index >= config->types_size) return NULL;
+    uint64_t offset = config->offsets[index];
+    return (uint8_t*)buffer + offset;
+}
+
+int skip_read_index_from_buffer(void* cfg, void* buffer, uint64_t buffer_size, void* value, uint64_t index) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (index >= config->types_size) return SKIP_ERROR_OUT_OF_BOUNDS;
+
+    SkipFieldPlan scratch;
+    const SkipFieldPlan* field = skip_get_field_plan(config, index, &scratch);
+
+    if (field->offset + field->byte_len > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    field->kernel((uint8_t*)value, (const uint8_t*)buffer + field->offset, field->byte_len);
+
+    return SKIP_SUCCESS;
+}
+
+// Element ranges reuse the field's kernel on a slice of it, so only the
+// touched elements are copied or swapped.
+static int skip_resolve_element_range(SkipConfig* config, uint64_t buffer_size, uint64_t index, uint64_t first, uint64_t count,
+                                      const SkipFieldPlan** out_field, SkipFieldPlan* scratch, uint64_t* out_element_size) {
+    if (!config) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (index >= config->types_size) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+    if (skip_get_var_element_size(config->types[index].type_code)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t element_count = config->types[index].count;
+    if (first > element_count || count > element_count - first) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    const SkipFieldPlan* field = skip_get_field_plan(config, index, scratch);
+    if (field->offset + field->byte_len > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *out_field = field;
+    *out_element_size = skip_get_datatype_size(config->types[index].type_code);
+    return SKIP_SUCCESS;
+}
+
+int skip_write_index_range(void* cfg, void* buffer, uint64_t buffer_size, const void* values, uint64_t index, uint64_t first, uint64_t count) {
+    const SkipFieldPlan* field;
+    SkipFieldPlan scratch;
+    uint64_t element_size;
+    int err = skip_resolve_element_range((SkipConfig*)cfg, buffer_size, index, first, count, &field, &scratch, &element_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    field->kernel((uint8_t*)buffer + field->offset + first * element_size, (const uint8_t*)values, count * element_size);
+    return SKIP_SUCCESS;
+}
+
+int skip_read_index_range(void* cfg, void* buffer, uint64_t buffer_size, void* values, uint64_t index, uint64_t first, uint64_t count) {
+    const SkipFieldPlan* field;
+    SkipFieldPlan scratch;
+    uint64_t element_size;
+    int err = skip_resolve_element_range((SkipConfig*)cfg, buffer_size, index, first, count, &field, &scratch, &element_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    field->kernel((uint8_t*)values, (const uint8_t*)buffer + field->offset + first * element_size, count * element_size);
+    return SKIP_SUCCESS;
+}
+
+int skip_gather_index_elements(void* cfg, void* buffer, uint64_t buffer_size, void* values, uint64_t index, const uint64_t* elements, uint64_t element_count) {
+    if (!elements && element_count > 0) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    const SkipFieldPlan* field;
+    SkipFieldPlan scratch;
+    uint64_t element_size;
+    int err = skip_resolve_element_range((SkipConfig*)cfg, buffer_size, index, 0, 0, &field, &scratch, &element_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint64_t field_count = ((SkipConfig*)cfg)->types[index].count;
+    for (uint64_t i = 0; i < element_count; ++i) {
+        if (elements[i] >= field_count) {
+            return SKIP_ERROR_OUT_OF_BOUNDS;
+        }
+    }
+
+    // Runs of consecutive indexes are transferred with one kernel call.
+    const uint8_t* src = (const uint8_t*)buffer + field->offset;
+    uint8_t* dst = (uint8_t*)values;
+    uint64_t i = 0;
+    while (i < element_count) {
+        uint64_t run = 1;
+        while (i + run < element_count && elements[i + run] == elements[i] + run) {
+            ++run;
+        }
+        field->kernel(dst, src + elements[i] * element_size, run * element_size);
+        dst += run * element_size;
+        i += run;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+
+int skip_create_nest_buffer(void* cfg, void* final_res, uint64_t final_res_size, void* data_buffer, uint64_t data_size) {
+    uint64_t header_body_size = skip_get_export_header_body_size(cfg);
+    if (final_res_size < header_body_size + data_size + sizeof(uint64_t)) {
+        return (int)SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    SkipConfig* config = (SkipConfig*)cfg;
+    uint64_t meta_size_to_write = header_body_size;
+
+    if (skip_get_system_endian() != config->endian) {
+        meta_size_to_write = swap_uint64(meta_size_to_write);
+    }
+
+    // The type table is serialized straight into its final position.
+    uint8_t* pos = (uint8_t*)final_res;
+    memcpy(pos, &meta_size_to_write, sizeof(uint64_t));
+    pos += sizeof(uint64_t);
+
+    int err = skip_export_header_body(cfg, (char*)pos, header_body_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    pos += header_body_size;
+
+    memcpy(pos, data_buffer, data_size);
+
+    return (int)SKIP_SUCCESS;
+}
+
+int skip_get_nest_cfg(void* cfg, void* nest_base_cfg, void* nest_buffer, uint64_t nest_size) {
+    SkipConfig* parent_config = (SkipConfig*)cfg;
+    uint64_t meta_size;
+    memcpy(&meta_size, nest_buffer, sizeof(uint64_t));
+
+    if (skip_get_system_endian() != parent_config->endian) {
+        meta_size = swap_uint64(meta_size);
+    }
+
+    if (nest_size < meta_size + sizeof(uint64_t)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    void* new_buffer_start = (uint8_t*)nest_buffer + sizeof(uint64_t);
+
+    int err = skip_set_endian_value_cfg(nest_base_cfg, skip_get_cfg_endian(cfg));
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    err = skip_import_header_body(nest_base_cfg, new_buffer_start, meta_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+int skip_get_nested_data_buffer(void* cfg, void* nest_buffer, uint64_t nest_size, void* data_buffer, uint64_t data_size) {
+    SkipConfig* parent_config = (SkipConfig*)cfg;
+    uint64_t meta_size;
+    memcpy(&meta_size, nest_buffer, sizeof(uint64_t));
+
+    if (skip_get_system_endian() != parent_config->endian) {
+        meta_size = swap_uint64(meta_size);
+    }
+
+    if (nest_size < meta_size + sizeof(uint64_t)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t actual_data_size = nest_size - meta_size - sizeof(uint64_t);
+
+    if (actual_data_size > data_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(data_buffer, (uint8_t*)nest_buffer + meta_size + sizeof(uint64_t), actual_data_size);
+
+    return SKIP_SUCCESS;
+}
+
+uint64_t skip_export_standalone_size(void* cfg) {
+    return skip_get_header_export_size() + skip_get_export_header_body_size(cfg) + skip_get_data_size(cfg);
+}
+
+int skip_export_standalone(void* cfg, void* data_buffer, uint64_t data_size, void* standalone_buffer, uint64_t standalone_size) {
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t header_body_size = skip_get_export_header_body_size(cfg);
+
+    if (standalone_size < header_size + header_body_size + data_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    int err = skip_write_header((SkipConfig*)cfg, (char*)standalone_buffer, header_size, header_body_size, data_size, 0);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint8_t* pos = (uint8_t*)standalone_buffer + header_size;
+    err = skip_export_header_body(cfg, (char*)pos, header_body_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    memcpy(pos + header_body_size, data_buffer, data_size);
+
+    return SKIP_SUCCESS;
+}
+
+int skip_import_standalone_get_cfg(void** out_cfg, void* buffer, uint64_t buffer_size) {
+    uint64_t header_body_size;
+    *out_cfg = skip_import_header(buffer, buffer_size, &header_body_size , NULL);
+    if (!*out_cfg) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+
+    void* new_buffer = (uint8_t*)buffer + skip_get_header_export_size();
+    int err = skip_import_header_body(*out_cfg, new_buffer, header_body_size);
+    if (err != SKIP_SUCCESS) {
+        skip_free_cfg(*out_cfg);
+        *out_cfg = NULL;
+        return err;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+
+int skip_import_standalone_get_data_buffer(void* cfg , void* buffer , uint64_t buffer_size , void* data_buffer , uint64_t data_buffer_size) {
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t header_body_size = skip_get_export_header_body_size(cfg);
+    uint64_t body_size = skip_get_data_size(cfg);
+
+    // Bodies with variable-length fields carry a heap after the fixed fields.
+    SkipHeader header;
+    if (skip_parse_header(buffer, buffer_size, &header) == SKIP_SUCCESS && header.data_size > body_size) {
+        body_size = header.data_size;
+    }
+    if (header_size + header_body_size + body_size > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+    
+    if (body_size > data_buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    void* new_buffer = (uint8_t*) buffer + header_size + header_body_size;
+
+    memcpy(data_buffer, new_buffer, body_size);
+
+    return SKIP_SUCCESS;
+}
+
+
+typedef struct {
+    uint8_t* map;
+    uint64_t map_size;
+    void* cfg;
+    uint8_t* data;
+    uint64_t data_size;
+    SkipAllocator allocator;
+} SkipMappedFile;
+
+int skip_mmap_advise(void* file, int advice) {
+#ifdef SKIP_HAVE_POSIX
+    SkipMappedFile* mapped = (SkipMappedFile*)file;
+    if (!mapped) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    int posix_advice;
+    switch (advice) {
+        case SKIP_ACCESS_NORMAL: posix_advice = MADV_NORMAL; break;
+        case SKIP_ACCESS_SEQUENTIAL: posix_advice = MADV_SEQUENTIAL; break;
+        case SKIP_ACCESS_RANDOM: posix_advice = MADV_RANDOM; break;
+        default: return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Advice is only a hint, so a kernel that ignores it is not an error.
+    madvise(mapped->map, (size_t)mapped->map_size, posix_advice);
+    return SKIP_SUCCESS;
+#else
+    (void)file;
+    (void)advice;
+    return SKIP_ERROR_INVALID_ARGUMENT;
+#endif
+}
+
+void* skip_mmap_open(const char* path, int advice) {
+#ifdef SKIP_HAVE_POSIX
+    if (!path) {
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size < skip_get_header_export_size()) {
+        close(fd);
+        return NULL;
+    }
+
+    uint64_t map_size = (uint64_t)st.st_size;
+    void* map = mmap(NULL, (size_t)map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipMappedFile* mapped = (SkipMappedFile*)skip_mem_alloc(&allocator, sizeof(SkipMappedFile));
+    if (!mapped) {
+        munmap(map, (size_t)map_size);
+        return NULL;
+    }
+    mapped->allocator = allocator;
+    mapped->map = (uint8_t*)map;
+    mapped->map_size = map_size;
+    mapped->cfg = NULL;
+
+    // The type table is parsed straight out of the mapping; the body is
+    // never copied.
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t body_size;
+    uint64_t data_size;
+    mapped->cfg = skip_import_header(map, map_size, &body_size, &data_size);
+    if (!mapped->cfg || body_size > map_size - header_size) {
+        skip_mmap_close(mapped);
+        return NULL;
+    }
+
+    if (skip_import_header_body(mapped->cfg, (const char*)map + header_size, body_size) != SKIP_SUCCESS) {
+        skip_mmap_close(mapped);
+        return NULL;
+    }
+
+    mapped->data = mapped->map + header_size + body_size;
+    mapped->data_size = data_size;
+    if (data_size < skip_get_data_size(mapped->cfg) || mapped->data_size > map_size - header_size - body_size) {
+        skip_mmap_close(mapped);
+        return NULL;
+    }
+
+    skip_mmap_advise(mapped, advice);
+    return mapped;
+#else
+    (void)path;
+    (void)advice;
+    return NULL;
+#endif
+}
+
+int skip_mmap_close(void* file) {
+#ifdef SKIP_HAVE_POSIX
+    if (file) {
+        SkipMappedFile* mapped = (SkipMappedFile*)file;
+        skip_free_cfg(mapped->cfg);
+        munmap(mapped->map, (size_t)mapped->map_size);
+        SkipAllocator allocator = mapped->allocator;
+        skip_mem_free(&allocator, mapped, sizeof(SkipMappedFile));
+    }
+#else
+    (void)file;
+#endif
+    return SKIP_SUCCESS;
+}
+
+void* skip_mmap_get_cfg(void* file) {
+    SkipMappedFile* mapped = (SkipMappedFile*)file;
+    return mapped ? mapped->cfg : NULL;
+}
+
+void* skip_mmap_get_data_ptr(void* file, uint64_t* out_data_size) {
+    SkipMappedFile* mapped = (SkipMappedFile*)file;
+    if (!mapped) {
+        return NULL;
+    }
+
+    if (out_data_size) {
+        *out_data_size = mapped->data_size;
+    }
+    return mapped->data;
+}
+
+void* skip_mmap_get_index_ptr(void* file, uint64_t index) {
+    SkipMappedFile* mapped = (SkipMappedFile*)file;
+    if (!mapped) {
+        return NULL;
+    }
+    return skip_get_index_ptr(mapped->cfg, mapped->data, index);
+}
+
+
+// Partial reads locate a byte range of one field from the type table alone,
+// so only the requested bytes of a large body are touched.
+static int skip_resolve_field_range(SkipConfig* config, const SkipFieldRange* range, uint64_t data_size,
+                                    uint64_t* out_offset, uint64_t* out_length, SkipSwapKernel* out_kernel) {
+    if (!range->value) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (range->index >= config->types_size) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    int32_t type_code = config->types[range->index].type_code;
+    if (skip_get_var_element_size(type_code)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t field_offset = config->offsets[range->index];
+    uint64_t field_len = config->offsets[range->index + 1] - field_offset;
+    uint64_t length = range->length ? range->length : field_len - (range->offset < field_len ? range->offset : field_len);
+    if (range->offset > field_len || length > field_len - range->offset) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    // Ranges must cover whole elements so they can be byte-swapped.
+    uint64_t unit = skip_get_swap_unit(type_code);
+    if (unit > 1 && (range->offset % unit != 0 || length % unit != 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (field_offset + range->offset + length > data_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *out_offset = field_offset + range->offset;
+    *out_length = length;
+    *out_kernel = unit > 1 && config->endian != skip_get_system_endian()
+        ? skip_select_swap_kernel(unit, skip_get_simd_level())
+        : skip_copy_kernel;
+    return SKIP_SUCCESS;
+}
+
+int skip_standalone_read_fields(void* cfg, const void* buffer, uint64_t buffer_size, const SkipFieldRange* ranges, uint64_t range_count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || (!ranges && range_count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    SkipHeader header;
+    int err = skip_parse_header((void*)buffer, buffer_size, &header);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    if (header.body_size > buffer_size - SKIP_HEADER_SIZE ||
+        header.data_size > buffer_size - SKIP_HEADER_SIZE - header.body_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+    // The offsets come from cfg, so it must describe this buffer.
+    if (header.endian != config->endian || header.data_size < skip_get_data_size(config)) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+
+    const uint8_t* data = (const uint8_t*)buffer + SKIP_HEADER_SIZE + header.body_size;
+    for (uint64_t i = 0; i < range_count; ++i) {
+        uint64_t offset;
+        uint64_t length;
+        SkipSwapKernel kernel;
+        err = skip_resolve_field_range(config, &ranges[i], header.data_size, &offset, &length, &kernel);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
+        kernel((uint8_t*)ranges[i].value, data + offset, length);
+    }
+
+    return SKIP_SUCCESS;
+}
+
+typedef struct {
+    int fd;
+    void* cfg;
+    uint64_t data_offset;
+    uint64_t data_size;
+    SkipAllocator allocator;
+} SkipPreadFile;
+
+#ifdef SKIP_HAVE_POSIX
+static int skip_pread_full(int fd, void* dst, uint64_t size, uint64_t offset) {
+    uint8_t* pos = (uint8_t*)dst;
+    while (size > 0) {
+        ssize_t got = pread(fd, pos, (size_t)size, (off_t)offset);
+        if (got <= 0) {
+            return SKIP_ERROR_IO_FAILED;
+        }
+        pos += got;
+        size -= (uint64_t)got;
+        offset += (uint64_t)got;
+    }
+    return SKIP_SUCCESS;
+}
+#endif
+
+void* skip_pread_open(int fd) {
+#ifdef SKIP_HAVE_POSIX
+    uint8_t header[SKIP_HEADER_SIZE];
+    if (fd < 0 || skip_pread_full(fd, header, sizeof(header), 0) != SKIP_SUCCESS) {
+        return NULL;
+    }
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipPreadFile* file = (SkipPreadFile*)skip_mem_alloc(&allocator, sizeof(SkipPreadFile));
+    if (!file) {
+        return NULL;
+    }
+    file->fd = fd;
+    file->allocator = allocator;
+
+    uint64_t body_size;
+    file->cfg = skip_import_header(header, sizeof(header), &body_size, &file->data_size);
+    if (!file->cfg) {
+        skip_pread_close(file);
+        return NULL;
+    }
+
+    // Both sizes come from the file, so check them against its real size
+    // before the table is allocated.
+    struct stat st;
+    uint64_t file_size = fstat(fd, &st) == 0 ? (uint64_t)st.st_size : 0;
+    if (file_size < SKIP_HEADER_SIZE || body_size > file_size - SKIP_HEADER_SIZE ||
+        file->data_size > file_size - SKIP_HEADER_SIZE - body_size) {
+        skip_pread_close(file);
+        return NULL;
+    }
+
+    // Only the type table is read here; the body stays on disk.
+    char* body = (char*)skip_mem_alloc(&allocator, body_size ? body_size : 1);
+    int err = body ? skip_pread_full(fd, body, body_size, SKIP_HEADER_SIZE) : SKIP_ERROR_ALLOCATION_FAILED;
+    if (err == SKIP_SUCCESS) {
+        err = skip_import_header_body(file->cfg, body, body_size);
+    }
+    skip_mem_free(&allocator, body, body_size ? body_size : 1);
+    if (err != SKIP_SUCCESS || file->data_size < skip_get_data_size(file->cfg)) {
+        skip_pread_close(file);
+        return NULL;
+    }
+
+    file->data_offset = SKIP_HEADER_SIZE + body_size;
+    return file;
+#else
+    (void)fd;
+    return NULL;
+#endif
+}
+
+int skip_pread_close(void* file) {
+    if (file) {
+        SkipPreadFile* pread_file = (SkipPreadFile*)file;
+        skip_free_cfg(pread_file->cfg);
+        SkipAllocator allocator = pread_file->allocator;
+        skip_mem_free(&allocator, pread_file, sizeof(SkipPreadFile));
+    }
+    return SKIP_SUCCESS;
+}
+
+void* skip_pread_get_cfg(void* file) {
+    SkipPreadFile* pread_file = (SkipPreadFile*)file;
+    return pread_file ? pread_file->cfg : NULL;
+}
+
+int skip_pread_fields(void* file, const SkipFieldRange* ranges, uint64_t range_count) {
+#ifdef SKIP_HAVE_POSIX
+    SkipPreadFile* pread_file = (SkipPreadFile*)file;
+    if (!pread_file || (!ranges && range_count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    SkipConfig* config = (SkipConfig*)pread_file->cfg;
+    for (uint64_t i = 0; i < range_count; ++i) {
+        uint64_t offset;
+        uint64_t length;
+        SkipSwapKernel kernel;
+        int err = skip_resolve_field_range(config, &ranges[i], pread_file->data_size, &offset, &length, &kernel);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
+
+        uint8_t* value = (uint8_t*)ranges[i].value;
+        err = skip_pread_full(pread_file->fd, value, length, pread_file->data_offset + offset);
+        if (err != SKIP_SUCCESS) {
+            return err;
+        }
+        kernel(value, value, length);
+    }
+
+    return SKIP_SUCCESS;
+#else
+    (void)file;
+    (void)ranges;
+    (void)range_count;
+    return SKIP_ERROR_IO_FAILED;
+#endif
+}
+
+#define SKIP_MIN_STREAM_CHUNK 64
+
+typedef struct {
+    SkipConfig* config;
+    SkipSinkFn sink;
+    void* user;
+
+    uint8_t* chunk;
+    uint64_t chunk_size;
+    uint64_t chunk_used;
+
+    uint64_t field;
+    uint64_t field_written;
+    int error;
+    SkipAllocator allocator;
+} SkipStreamWriter;
+
+static int skip_stream_flush(SkipStreamWriter* writer) {
+    if (writer->chunk_used > 0) {
+        int err = writer->sink(writer->user, writer->chunk, writer->chunk_used);
+        writer->chunk_used = 0;
+        if (err != SKIP_SUCCESS) {
+            writer->error = err;
+            return err;
+        }
+    }
+    return SKIP_SUCCESS;
+}
+
+static int skip_stream_write_table(SkipStreamWriter* writer);
+static int skip_stream_write_names(SkipStreamWriter* writer);
+
+// Streams carry only the fixed fields. A heap field would arrive as a slot
+// pointing past the end of the data, so both ends refuse such schemas.
+static int skip_has_heap_fields(SkipConfig* config) {
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        if (skip_get_var_element_size(config->types[i].type_code)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void* skip_create_stream_writer(void* cfg, SkipSinkFn sink, void* user, uint64_t chunk_size) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !sink || skip_has_heap_fields(config)) {
+        return NULL;
+    }
+
+    // Keep whole elements and whole table entries inside one chunk.
+    if (chunk_size < SKIP_MIN_STREAM_CHUNK) {
+        chunk_size = SKIP_MIN_STREAM_CHUNK;
+    }
+    chunk_size -= chunk_size % 8;
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipStreamWriter* writer = (SkipStreamWriter*)skip_mem_alloc(&allocator, sizeof(SkipStreamWriter));
+    if (!writer) return NULL;
+    writer->allocator = allocator;
+
+    writer->chunk = (uint8_t*)skip_mem_alloc(&allocator, chunk_size);
+    if (!writer->chunk) {
+        skip_mem_free(&allocator, writer, sizeof(SkipStreamWriter));
+        return NULL;
+    }
+
+    writer->config = config;
+    writer->sink = sink;
+    writer->user = user;
+    writer->chunk_size = chunk_size;
+    writer->chunk_used = 0;
+    writer->field = 0;
+    writer->field_written = 0;
+    writer->error = SKIP_SUCCESS;
+
+    uint64_t header_size = skip_get_header_export_size();
+    int err = skip_export_header(config, (char*)writer->chunk, chunk_size, NULL);
+    if (err != SKIP_SUCCESS) {
+        skip_free_stream_writer(writer);
+        return NULL;
+    }
+    writer->chunk_used = header_size;
+
+    // The chunk holds at least SKIP_MIN_STREAM_CHUNK bytes, so the named
+    // body prefix fits after the header.
+    if (config->named_count > 0) {
+        writer->chunk[writer->chunk_used++] = SKIP_NAMED_BODY_MARKER;
+        writer->chunk_used += skip_put_varint(writer->chunk + writer->chunk_used, skip_get_table_size(config));
+    }
+
+    if (skip_stream_write_table(writer) != SKIP_SUCCESS ||
+        (config->named_count > 0 && skip_stream_write_names(writer) != SKIP_SUCCESS)) {
+        skip_free_stream_writer(writer);
+        return NULL;
+    }
+
+    return writer;
+}
+
+static int skip_stream_write_table(SkipStreamWriter* writer) {
+    SkipConfig* config = writer->config;
+    if (config->header_format == SKIP_HEADER_FORMAT_COMPACT) {
+        writer->chunk[writer->chunk_used++] = SKIP_COMPACT_BODY_MARKER;
+        for (uint64_t i = 0; i < config->types_size;) {
+            if (writer->chunk_size - writer->chunk_used < SKIP_COMPACT_MAX_RUN && skip_stream_flush(writer) != SKIP_SUCCESS) {
+                return writer->error;
+            }
+            uint64_t run = skip_compact_run_length(config, i);
+            writer->chunk_used += skip_encode_compact_run(config, i, run, writer->chunk + writer->chunk_used);
+            i += run;
+        }
+        return SKIP_SUCCESS;
+    }
+
+    uint64_t entry = 0;
+    while (entry < config->types_size) {
+        uint64_t room = (writer->chunk_size - writer->chunk_used) / SKIP_HEADER_ENTRY_SIZE;
+        if (room == 0) {
+            if (skip_stream_flush(writer) != SKIP_SUCCESS) {
+                return writer->error;
+            }
+            continue;
+        }
+
+        uint64_t n = config->types_size - entry < room ? config->types_size - entry : room;
+        skip_export_header_entries(config, entry, n, (char*)writer->chunk + writer->chunk_used);
+        writer->chunk_used += n * SKIP_HEADER_ENTRY_SIZE;
+        entry += n;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+static int skip_stream_put(SkipStreamWriter* writer, const uint8_t* data, uint64_t size) {
+    while (size > 0) {
+        if (writer->chunk_used == writer->chunk_size && skip_stream_flush(writer) != SKIP_SUCCESS) {
+            return writer->error;
+        }
+        uint64_t n = writer->chunk_size - writer->chunk_used < size ? writer->chunk_size - writer->chunk_used : size;
+        memcpy(writer->chunk + writer->chunk_used, data, n);
+        writer->chunk_used += n;
+        data += n;
+        size -= n;
+    }
+    return SKIP_SUCCESS;
+}
+
+static int skip_stream_write_names(SkipStreamWriter* writer) {
+    SkipConfig* config = writer->config;
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        uint64_t length = 0;
+        const uint8_t* name = NULL;
+        if (i < config->field_names_size) {
+            length = config->field_names[i].length;
+            name = (const uint8_t*)config->names + config->field_names[i].offset;
+        }
+
+        uint8_t prefix[SKIP_VARINT_MAX_SIZE];
+        if (skip_stream_put(writer, prefix, skip_put_varint(prefix, length)) != SKIP_SUCCESS ||
+            (length > 0 && skip_stream_put(writer, name, length) != SKIP_SUCCESS)) {
+            return writer->error;
+        }
+    }
+    return SKIP_SUCCESS;
+}
+
+int skip_stream_write_elements(void* stream, const void* values, uint64_t count) {
+    SkipStreamWriter* writer = (SkipStreamWriter*)stream;
+    if (!writer || (!values && count > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (writer->error != SKIP_SUCCESS) {
+        return writer->error;
+    }
+
+    const uint8_t* src = (const uint8_t*)values;
+    while (count > 0) {
+        if (writer->field >= writer->config->types_size) {
+            return SKIP_ERROR_OUT_OF_BOUNDS;
+        }
+
+        SkipFieldPlan field;
+        skip_build_field_plan(writer->config, writer->field, &field);
+
+        if (field.byte_len == 0) {
+            writer->field++;
+            continue;
+        }
+
+        uint64_t type_size = field.type_size;
+        uint64_t remaining = (field.byte_len - writer->field_written) / type_size;
+        uint64_t room = (writer->chunk_size - writer->chunk_used) / type_size;
+        uint64_t n = count < remaining ? count : remaining;
+        if (n > room) n = room;
+
+        if (n == 0) {
+            if (skip_stream_flush(writer) != SKIP_SUCCESS) {
+                return writer->error;
+            }
+            continue;
+        }
+
+        field.kernel(writer->chunk + writer->chunk_used, src, n * type_size);
+        writer->chunk_used += n * type_size;
+        writer->field_written += n * type_size;
+        src += n * type_size;
+        count -= n;
+
+        if (writer->field_written == field.byte_len) {
+            writer->field++;
+            writer->field_written = 0;
+        }
+    }
+
+    return SKIP_SUCCESS;
+}
+
+int skip_stream_write_field(void* stream, uint64_t index, const void* value) {
+    SkipStreamWriter* writer = (SkipStreamWriter*)stream;
+    if (!writer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (index != writer->field || writer->field_written != 0) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    int err = skip_stream_write_elements(writer, value, writer->config->types[index].count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    // Zero-length fields have no elements to advance past them.
+    if (writer->field == index) {
+        writer->field++;
+    }
+    return SKIP_SUCCESS;
+}
+
+int skip_finish_stream_writer(void* stream) {
+    SkipStreamWriter* writer = (SkipStreamWriter*)stream;
+    if (!writer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (writer->error != SKIP_SUCCESS) {
+        return writer->error;
+    }
+
+    while (writer->field < writer->config->types_size && skip_get_datatype_size(writer->config->types[writer->field].type_code) * writer->config->types[writer->field].count == 0) {
+        writer->field++;
+    }
+
+    if (writer->field != writer->config->types_size) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+
+    return skip_stream_flush(writer);
+}
+
+int skip_free_stream_writer(void* stream) {
+    if (stream) {
+        SkipStreamWriter* writer = (SkipStreamWriter*)stream;
+        SkipAllocator allocator = writer->allocator;
+        skip_mem_free(&allocator, writer->chunk, writer->chunk_size);
+        skip_mem_free(&allocator, writer, sizeof(SkipStreamWriter));
+    }
+    return SKIP_SUCCESS;
+}
+
+int skip_fd_sink(void* user, const void* data, uint64_t size) {
+#ifdef SKIP_HAVE_POSIX
+    int fd = *(int*)user;
+    const uint8_t* pos = (const uint8_t*)data;
+    while (size > 0) {
+        ssize_t written = write(fd, pos, (size_t)size);
+        if (written <= 0) {
+            return SKIP_ERROR_IO_FAILED;
+        }
+        pos += written;
+        size -= (uint64_t)written;
+    }
+    return SKIP_SUCCESS;
+#else
+    (void)user;
+    (void)data;
+    (void)size;
+    return SKIP_ERROR_IO_FAILED;
+#endif
+}
+
+
+enum {
+    SKIP_STREAM_HEADER = 0,
+    SKIP_STREAM_TABLE = 1,
+    SKIP_STREAM_FIELDS = 2,
+    SKIP_STREAM_DONE = 3
+};
+
+typedef struct {
+    SkipFieldFn on_field;
+    void* user;
+    int state;
+    void* cfg;
+
+    // Bytes of the header, the table or the current field piece collected so
+    // far. The table needs all of it at once; field pieces are flushed every
+    // chunk_size bytes.
+    uint8_t* pending;
+    uint64_t pending_capacity;
+    uint64_t pending_used;
+    uint64_t pending_target;
+
+    uint64_t chunk_size;
+    uint64_t max_table_size;
+    uint64_t field;
+    uint64_t field_offset;
+    SkipFieldPlan plan;
+    int error;
+    SkipAllocator allocator;
+} SkipStreamReader;
+
+// The table size in a stream header is untrusted and is buffered whole, so
+// it is checked against this limit before anything is allocated for it.
+#define SKIP_DEFAULT_MAX_STREAM_TABLE (16u << 20)
+
+void* skip_create_stream_reader(SkipFieldFn on_field, void* user, uint64_t chunk_size) {
+    if (!on_field) {
+        return NULL;
+    }
+
+    if (chunk_size < SKIP_MIN_STREAM_CHUNK) {
+        chunk_size = SKIP_MIN_STREAM_CHUNK;
+    }
+    chunk_size -= chunk_size % 8;
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipStreamReader* reader = (SkipStreamReader*)skip_mem_alloc(&allocator, sizeof(SkipStreamReader));
+    if (!reader) return NULL;
+    reader->allocator = allocator;
+
+    reader->pending_capacity = chunk_size;
+    reader->pending = (uint8_t*)skip_mem_alloc(&allocator, chunk_size);
+    if (!reader->pending) {
+        skip_mem_free(&allocator, reader, sizeof(SkipStreamReader));
+        return NULL;
+    }
+
+    reader->on_field = on_field;
+    reader->user = user;
+    reader->state = SKIP_STREAM_HEADER;
+    reader->cfg = NULL;
+    reader->pending_used = 0;
+    reader->pending_target = skip_get_header_export_size();
+    reader->chunk_size = chunk_size;
+    reader->max_table_size = SKIP_DEFAULT_MAX_STREAM_TABLE;
+    reader->field = 0;
+    reader->field_offset = 0;
+    reader->error = SKIP_SUCCESS;
+
+    return reader;
+}
+
+int skip_set_stream_reader_max_table_size(void* stream, uint64_t max_size) {
+    SkipStreamReader* reader = (SkipStreamReader*)stream;
+    if (!reader) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (reader->state != SKIP_STREAM_HEADER) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    reader->max_table_size = max_size;
+    return SKIP_SUCCESS;
+}
+
+// Moves to the next field that has data, or to the done state.
+static void skip_stream_next_field(SkipStreamReader* reader) {
+    SkipConfig* config = (SkipConfig*)reader->cfg;
+    while (reader->field < config->types_size) {
+        skip_build_field_plan(config, reader->field, &reader->plan);
+        if (reader->plan.byte_len > 0) {
+            uint64_t left = reader->plan.byte_len - reader->field_offset;
+            uint64_t piece = reader->chunk_size - reader->chunk_size % (reader->plan.type_size ? reader->plan.type_size : 1);
+            reader->pending_target = left < piece ? left : piece;
+            return;
+        }
+        reader->field++;
+    }
+    reader->state = SKIP_STREAM_DONE;
+}
+
+static int skip_stream_complete_pending(SkipStreamReader* reader) {
+    switch (reader->state) {
+        case SKIP_STREAM_HEADER: {
+            uint64_t body_size;
+            reader->cfg = skip_import_header(reader->pending, reader->pending_used, &body_size, NULL);
+            if (!reader->cfg) {
+                return SKIP_ERROR_INVALID_CONFIG;
+            }
+            if (body_size > reader->max_table_size) {
+                skip_free_cfg(reader->cfg);
+                reader->cfg = NULL;
+                return SKIP_ERROR_INVALID_CONFIG;
+            }
+
+            if (body_size > reader->pending_capacity) {
+                uint8_t* grown = (uint8_t*)reader->allocator.realloc(reader->allocator.user, reader->pending, reader->pending_capacity, body_size);
+                if (!grown) {
+                    skip_free_cfg(reader->cfg);
+                    reader->cfg = NULL;
+                    return SKIP_ERROR_ALLOCATION_FAILED;
+                }
+                reader->pending = grown;
+                reader->pending_capacity = body_size;
+            }
+
+            reader->state = SKIP_STREAM_TABLE;
+            reader->pending_target = body_size;
+            return SKIP_SUCCESS;
+        }
+        case SKIP_STREAM_TABLE: {
+            int err = skip_import_header_body(reader->cfg, (const char*)reader->pending, reader->pending_used);
+            if (err != SKIP_SUCCESS) {
+                return err;
+            }
+            if (skip_has_heap_fields(reader->cfg)) {
+                return SKIP_ERROR_INVALID_CONFIG;
+            }
+
+            reader->state = SKIP_STREAM_FIELDS;
+            skip_stream_next_field(reader);
+            return SKIP_SUCCESS;
+        }
+        case SKIP_STREAM_FIELDS: {
+            reader->plan.kernel(reader->pending, reader->pending, reader->pending_used);
+            int err = reader->on_field(reader->user, reader->field, reader->field_offset, reader->pending, reader->pending_used);
+            if (err != SKIP_SUCCESS) {
+                return err;
+            }
+
+            reader->field_offset += reader->pending_used;
+            if (reader->field_offset == reader->plan.byte_len) {
+                reader->field++;
+                reader->field_offset = 0;
+            }
+            skip_stream_next_field(reader);
+            return SKIP_SUCCESS;
+        }
+        default:
+            return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+}
+
+int skip_stream_reader_feed(void* stream, const void* data, uint64_t size) {
+    SkipStreamReader* reader = (SkipStreamReader*)stream;
+    if (!reader || (!data && size > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    // A failed stream stays failed; later bytes are not parsed as a new one.
+    if (reader->error != SKIP_SUCCESS) {
+        return reader->error;
+    }
+
+    const uint8_t* src = (const uint8_t*)data;
+    while (size > 0 || (reader->state == SKIP_STREAM_TABLE && reader->pending_target == 0)) {
+        if (reader->state == SKIP_STREAM_DONE) {
+            return SKIP_ERROR_OUT_OF_BOUNDS;
+        }
+
+        uint64_t want = reader->pending_target - reader->pending_used;
+        uint64_t n = size < want ? size : want;
+        memcpy(reader->pending + reader->pending_used, src, (size_t)n);
+        reader->pending_used += n;
+        src += n;
+        size -= n;
+
+        if (reader->pending_used == reader->pending_target) {
+            int err = skip_stream_complete_pending(reader);
+            reader->pending_used = 0;
+            if (err != SKIP_SUCCESS) {
+                reader->error = err;
+                return err;
+            }
+        }
+    }
+
+    return SKIP_SUCCESS;
+}
+
+void* skip_stream_reader_get_cfg(void* stream) {
+    SkipStreamReader* reader = (SkipStreamReader*)stream;
+    if (!reader || reader->state < SKIP_STREAM_FIELDS) {
+        return NULL;
+    }
+    return reader->cfg;
+}
+
+int skip_stream_reader_is_done(void* stream) {
+    SkipStreamReader* reader = (SkipStreamReader*)stream;
+    return reader && reader->state == SKIP_STREAM_DONE;
+}
+
+int skip_free_stream_reader(void* stream) {
+    if (stream) {
+        SkipStreamReader* reader = (SkipStreamReader*)stream;
+        skip_free_cfg(reader->cfg);
+        SkipAllocator allocator = reader->allocator;
+        skip_mem_free(&allocator, reader->pending, reader->pending_capacity);
+        skip_mem_free(&allocator, reader, sizeof(SkipStreamReader));
+    }
+    return SKIP_SUCCESS;
+}
+
+
+#define SKIP_ARENA_ALIGN 16
+
+typedef struct {
+    uint8_t* base;
+    uint64_t capacity;
+    uint64_t used;
+    uint64_t last;
+    SkipAllocator allocator;
+} SkipArena;
+
+static void* skip_arena_alloc(void* user, uint64_t size) {
+    SkipArena* arena = (SkipArena*)user;
+    uint64_t start = (arena->used + SKIP_ARENA_ALIGN - 1) & ~(uint64_t)(SKIP_ARENA_ALIGN - 1);
+    if (start > arena->capacity || size > arena->capacity - start) {
+        return NULL;
+    }
+    arena->last = start;
+    arena->used = start + size;
+    return arena->base + start;
+}
+
+static void* skip_arena_realloc(void* user, void* ptr, uint64_t old_size, uint64_t new_size) {
+    SkipArena* arena = (SkipArena*)user;
+    if (!ptr) {
+        return skip_arena_alloc(user, new_size);
+    }
+
+    // The most recent allocation can grow in place; anything else is copied
+    // to the top of the region and the old bytes are released with the arena.
+    uint8_t* p = (uint8_t*)ptr;
+    if (p == arena->base + arena->last && new_size <= arena->capacity - arena->last) {
+        arena->used = arena->last + new_size;
+        return ptr;
+    }
+
+    void* grown = skip_arena_alloc(user, new_size);
+    if (grown) {
+        memcpy(grown, ptr, (size_t)(old_size < new_size ? old_size : new_size));
+    }
+    return grown;
+}
+
+static void skip_arena_free(void* user, void* ptr, uint64_t size) {
+    (void)user;
+    (void)ptr;
+    (void)size;
+}
+
+void* skip_create_arena(uint64_t capacity) {
+    SkipAllocator allocator = skip_global_allocator;
+    SkipArena* arena = (SkipArena*)skip_mem_alloc(&allocator, sizeof(SkipArena));
+    if (!arena) return NULL;
+    arena->allocator = allocator;
+
+    arena->base = (uint8_t*)skip_mem_alloc(&allocator, capacity ? capacity : 1);
+    if (!arena->base) {
+        skip_mem_free(&allocator, arena, sizeof(SkipArena));
+        return NULL;
+    }
+    arena->capacity = capacity;
+    arena->used = 0;
+    arena->last = 0;
+
+    return arena;
+}
+
+int skip_get_arena_allocator(void* arena, SkipAllocator* out_allocator) {
+    if (!arena || !out_allocator) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    out_allocator->alloc = skip_arena_alloc;
+    out_allocator->realloc = skip_arena_realloc;
+    out_allocator->free = skip_arena_free;
+    out_allocator->user = arena;
+    return SKIP_SUCCESS;
+}
+
+uint64_t skip_get_arena_used(void* arena) {
+    SkipArena* region = (SkipArena*)arena;
+    return region->used;
+}
+
+int skip_reset_arena(void* arena) {
+    SkipArena* region = (SkipArena*)arena;
+    if (!region) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    region->used = 0;
+    region->last = 0;
+    return SKIP_SUCCESS;
+}
+
+int skip_free_arena(void* arena) {
+    if (arena) {
+        SkipArena* region = (SkipArena*)arena;
+        SkipAllocator allocator = region->allocator;
+        skip_mem_free(&allocator, region->base, region->capacity ? region->capacity : 1);
+        skip_mem_free(&allocator, region, sizeof(SkipArena));
+    }
+    return SKIP_SUCCESS;
+}
+
+
+typedef struct SkipCacheEntry {
+    uint64_t hash;
+    int endian;
+    int layout;
+    uint8_t* body;
+    uint64_t body_size;
+    SkipConfig* cfg;
+    struct SkipCacheEntry* next;
+} SkipCacheEntry;
+
+typedef struct {
+    SkipMutex lock;
+    SkipCacheEntry** buckets;
+    uint64_t bucket_count;
+    uint64_t entry_count;
+    uint64_t max_entries;
+    uint64_t hits;
+    uint64_t misses;
+    SkipAllocator allocator;
+} SkipConfigCache;
+
+#define SKIP_CACHE_INITIAL_BUCKETS 64
+
+void* skip_create_config_cache(uint64_t max_entries) {
+    SkipAllocator allocator = skip_global_allocator;
+    SkipConfigCache* cache = (SkipConfigCache*)skip_mem_alloc(&allocator, sizeof(SkipConfigCache));
+    if (!cache) return NULL;
+    cache->allocator = allocator;
+
+    cache->buckets = (SkipCacheEntry**)skip_mem_alloc(&allocator, SKIP_CACHE_INITIAL_BUCKETS * sizeof(SkipCacheEntry*));
+    if (!cache->buckets) {
+        skip_mem_free(&allocator, cache, sizeof(SkipConfigCache));
+        return NULL;
+    }
+    memset(cache->buckets, 0, SKIP_CACHE_INITIAL_BUCKETS * sizeof(SkipCacheEntry*));
+
+    cache->bucket_count = SKIP_CACHE_INITIAL_BUCKETS;
+    cache->entry_count = 0;
+    cache->max_entries = max_entries;
+    cache->hits = 0;
+    cache->misses = 0;
+    skip_mutex_init(&cache->lock);
+
+    return cache;
+}
+
+int skip_free_config_cache(void* cache) {
+    if (cache) {
+        SkipConfigCache* table = (SkipConfigCache*)cache;
+        SkipAllocator allocator = table->allocator;
+        for (uint64_t b = 0; b < table->bucket_count; ++b) {
+            SkipCacheEntry* entry = table->buckets[b];
+            while (entry) {
+                SkipCacheEntry* next = entry->next;
+                skip_free_cfg(entry->cfg);
+                skip_mem_free(&allocator, entry->body, entry->body_size ? entry->body_size : 1);
+                skip_mem_free(&allocator, entry, sizeof(SkipCacheEntry));
+                entry = next;
+            }
+        }
+        skip_mem_free(&allocator, table->buckets, table->bucket_count * sizeof(SkipCacheEntry*));
+        skip_mutex_destroy(&table->lock);
+        skip_mem_free(&allocator, table, sizeof(SkipConfigCache));
+    }
+    return SKIP_SUCCESS;
+}
+
+static void skip_cache_grow(SkipConfigCache* cache) {
+    uint64_t new_count = cache->bucket_count * 2;
+    SkipCacheEntry** buckets = (SkipCacheEntry**)skip_mem_alloc(&cache->allocator, new_count * sizeof(SkipCacheEntry*));
+    if (!buckets) {
+        // Longer chains are slower but still correct.
+        return;
+    }
+    memset(buckets, 0, (size_t)(new_count * sizeof(SkipCacheEntry*)));
+
+    for (uint64_t b = 0; b < cache->bucket_count; ++b) {
+        SkipCacheEntry* entry = cache->buckets[b];
+        while (entry) {
+            SkipCacheEntry* next = entry->next;
+            uint64_t slot = entry->hash & (new_count - 1);
+            entry->next = buckets[slot];
+            buckets[slot] = entry;
+            entry = next;
+        }
+    }
+
+    skip_mem_free(&cache->allocator, cache->buckets, cache->bucket_count * sizeof(SkipCacheEntry*));
+    cache->buckets = buckets;
+    cache->bucket_count = new_count;
+}
+
+static SkipConfig* skip_build_shared_cfg(int endian, int layout, const char* body, uint64_t body_size) {
+    SkipConfig* config = (SkipConfig*)skip_create_base_config();
+    if (!config) {
+        return NULL;
+    }
+
+    if (skip_set_endian_value_cfg(config, endian) != SKIP_SUCCESS ||
+        skip_set_record_layout_cfg(config, layout) != SKIP_SUCCESS ||
+        skip_import_header_body(config, body, body_size) != SKIP_SUCCESS || skip_compile_config(config) != SKIP_SUCCESS) {
+        skip_free_cfg(config);
+        return NULL;
+    }
+    return config;
+}
+
+static uint64_t skip_schema_hash(int endian, int layout, const char* body, uint64_t body_size) {
+    return skip_hash_bytes(body, body_size, ((uint64_t)endian << 8) | (uint64_t)layout);
+}
+
+// Returns a new reference to the cached config, or builds one. When the
+// cache is full the built config is private and *out_interned is 0.
+// Must be called with the cache lock held.
+static int skip_cache_acquire(SkipConfigCache* table, uint64_t hash, int endian, int layout, const char* buffer, uint64_t buffer_size, SkipConfig** out_cfg, int* out_interned) {
+    SkipCacheEntry* entry = table->buckets[hash & (table->bucket_count - 1)];
+    while (entry) {
+        if (entry->hash == hash && entry->endian == endian && entry->layout == layout &&
+            entry->body_size == buffer_size && memcmp(entry->body, buffer, (size_t)buffer_size) == 0) {
+            skip_atomic_add(&entry->cfg->refcount, 1);
+            table->hits++;
+            *out_cfg = entry->cfg;
+            *out_interned = 1;
+            return SKIP_SUCCESS;
+        }
+        entry = entry->next;
+    }
+    table->misses++;
+
+    SkipConfig* config = skip_build_shared_cfg(endian, layout, buffer, buffer_size);
+    if (!config) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    *out_cfg = config;
+    *out_interned = 0;
+
+    // A full cache still answers, it just stops interning new schemas.
+    if (table->max_entries != 0 && table->entry_count >= table->max_entries) {
+        return SKIP_SUCCESS;
+    }
+
+    entry = (SkipCacheEntry*)skip_mem_alloc(&table->allocator, sizeof(SkipCacheEntry));
+    uint8_t* body = (uint8_t*)skip_mem_alloc(&table->allocator, buffer_size ? buffer_size : 1);
+    if (!entry || !body) {
+        skip_mem_free(&table->allocator, entry, sizeof(SkipCacheEntry));
+        skip_mem_free(&table->allocator, body, buffer_size ? buffer_size : 1);
+        return SKIP_SUCCESS;
+    }
+    memcpy(body, buffer, (size_t)buffer_size);
+
+    // One reference for the cache and one for the caller.
+    config->shared = 1;
+    config->refcount = 2;
+
+    entry->hash = hash;
+    entry->endian = endian;
+    entry->layout = layout;
+    entry->body = body;
+    entry->body_size = buffer_size;
+    entry->cfg = config;
+
+    uint64_t slot = hash & (table->bucket_count - 1);
+    entry->next = table->buckets[slot];
+    table->buckets[slot] = entry;
+    table->entry_count++;
+    if (table->entry_count > table->bucket_count - table->bucket_count / 4) {
+        skip_cache_grow(table);
+    }
+
+    *out_interned = 1;
+    return SKIP_SUCCESS;
+}
+
+int skip_config_cache_import_header_body(void* cache, void** out_cfg, int endian, int layout, const char* buffer, uint64_t buffer_size) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    if (!table || !out_cfg || (!buffer && buffer_size > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    *out_cfg = NULL;
+
+    uint64_t hash = skip_schema_hash(endian, layout, buffer, buffer_size);
+    SkipConfig* config = NULL;
+    int interned = 0;
+
+    skip_mutex_lock(&table->lock);
+    int err = skip_cache_acquire(table, hash, endian, layout, buffer, buffer_size, &config, &interned);
+    skip_mutex_unlock(&table->lock);
+
+    *out_cfg = config;
+    return err;
+}
+
+int skip_config_cache_import_standalone(void* cache, void** out_cfg, void* buffer, uint64_t buffer_size) {
+    if (!cache || !out_cfg || !buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    *out_cfg = NULL;
+
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t header_body_size;
+    void* header_cfg = skip_import_header(buffer, buffer_size, &header_body_size, NULL);
+    if (!header_cfg) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    int endian = skip_get_cfg_endian(header_cfg);
+    int layout = skip_get_record_layout_cfg(header_cfg);
+    skip_free_cfg(header_cfg);
+
+    if (header_body_size > buffer_size - header_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    return skip_config_cache_import_header_body(cache, out_cfg, endian, layout, (const char*)buffer + header_size, header_body_size);
+}
+
+int skip_config_cache_get_stats(void* cache, uint64_t* out_hits, uint64_t* out_misses, uint64_t* out_entries) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    if (!table) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    skip_mutex_lock(&table->lock);
+    if (out_hits) *out_hits = table->hits;
+    if (out_misses) *out_misses = table->misses;
+    if (out_entries) *out_entries = table->entry_count;
+    skip_mutex_unlock(&table->lock);
+
+    return SKIP_SUCCESS;
+}
+
+int skip_is_config_shared(void* cfg) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    return config->shared;
+}
+
+static int skip_load_fingerprint(SkipConfig* config, uint64_t* out_fingerprint) {
+    if (config->compiled) {
+        *out_fingerprint = config->fingerprint;
+        return SKIP_SUCCESS;
+    }
+    return skip_compute_fingerprint(config, out_fingerprint);
+}
+
+uint64_t skip_get_schema_fingerprint(void* cfg) {
+    uint64_t fingerprint = 0;
+    skip_load_fingerprint((SkipConfig*)cfg, &fingerprint);
+    return fingerprint;
+}
+
+int skip_config_cache_register(void* cache, void* cfg) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!table || !config) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t body_size = skip_get_export_header_body_size(config);
+    char* body = (char*)skip_mem_alloc(&config->allocator, body_size ? body_size : 1);
+    if (!body) {
+        return SKIP_ERROR_ALLOCATION_FAILED;
+    }
+    skip_export_header_body(config, body, body_size);
+
+    uint64_t hash = skip_schema_hash(config->endian, config->layout, body, body_size);
+    SkipConfig* cached = NULL;
+    int interned = 0;
+
+    skip_mutex_lock(&table->lock);
+    int err = skip_cache_acquire(table, hash, config->endian, config->layout, body, body_size, &cached, &interned);
+    skip_mutex_unlock(&table->lock);
+    skip_mem_free(&config->allocator, body, body_size ? body_size : 1);
+
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    skip_free_cfg(cached);
+
+    return interned ? SKIP_SUCCESS : SKIP_ERROR_OUT_OF_BOUNDS;
+}
+
+int skip_config_cache_find(void* cache, uint64_t fingerprint, void** out_cfg) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    if (!table || !out_cfg) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    *out_cfg = NULL;
+
+    skip_mutex_lock(&table->lock);
+    SkipCacheEntry* entry = table->buckets[fingerprint & (table->bucket_count - 1)];
+    while (entry && entry->hash != fingerprint) {
+        entry = entry->next;
+    }
+    if (entry) {
+        skip_atomic_add(&entry->cfg->refcount, 1);
+        table->hits++;
+        *out_cfg = entry->cfg;
+    } else {
+        table->misses++;
+    }
+    skip_mutex_unlock(&table->lock);
+
+    return entry ? SKIP_SUCCESS : SKIP_ERROR_UNKNOWN_SCHEMA;
+}
+
+// The registry file is a sequence of exported headers, each followed by
+// its type table.
+int skip_config_cache_save_file(void* cache, const char* path) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    if (!table || !path) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t header_size = skip_get_header_export_size();
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return SKIP_ERROR_IO_FAILED;
+    }
+
+    char header[SKIP_HEADER_SIZE];
+    int err = SKIP_SUCCESS;
+
+    skip_mutex_lock(&table->lock);
+    for (uint64_t b = 0; b < table->bucket_count && err == SKIP_SUCCESS; ++b) {
+        for (SkipCacheEntry* entry = table->buckets[b]; entry && err == SKIP_SUCCESS; entry = entry->next) {
+            err = skip_write_header(entry->cfg, header, sizeof(header), entry->body_size, skip_get_data_size(entry->cfg), 0);
+            if (err != SKIP_SUCCESS) {
+                break;
+            }
+            if (fwrite(header, 1, (size_t)header_size, file) != header_size ||
+                fwrite(entry->body, 1, (size_t)entry->body_size, file) != entry->body_size) {
+                err = SKIP_ERROR_IO_FAILED;
+            }
+        }
+    }
+    skip_mutex_unlock(&table->lock);
+
+    if (fclose(file) != 0 && err == SKIP_SUCCESS) {
+        err = SKIP_ERROR_IO_FAILED;
+    }
+    return err;
+}
+
+int skip_config_cache_load_file(void* cache, const char* path) {
+    SkipConfigCache* table = (SkipConfigCache*)cache;
+    if (!table || !path) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return SKIP_ERROR_IO_FAILED;
+    }
+
+    long file_size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        file_size = ftell(file);
+    }
+    if (file_size < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return SKIP_ERROR_IO_FAILED;
+    }
+
+    uint64_t size = (uint64_t)file_size;
+    uint8_t* contents = (uint8_t*)skip_mem_alloc(&table->allocator, size ? size : 1);
+    if (!contents) {
+        fclose(file);
+        return SKIP_ERROR_ALLOCATION_FAILED;
+    }
+    uint64_t read_size = fread(contents, 1, (size_t)size, file);
+    fclose(file);
+    if (read_size != size) {
+        skip_mem_free(&table->allocator, contents, size ? size : 1);
+        return SKIP_ERROR_IO_FAILED;
+    }
+
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t pos = 0;
+    int err = SKIP_SUCCESS;
+    while (pos < size && err == SKIP_SUCCESS) {
+        SkipHeader header;
+        err = skip_parse_header(contents + pos, size - pos, &header);
+        if (err != SKIP_SUCCESS) {
+            break;
+        }
+        pos += header_size;
+        if (header.body_size > size - pos) {
+            err = SKIP_ERROR_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        void* cfg = NULL;
+        err = skip_config_cache_import_header_body(table, &cfg, header.endian, header.reserved[0], (const char*)contents + pos, header.body_size);
+        skip_free_cfg(cfg);
+        pos += header.body_size;
+    }
+
+    skip_mem_free(&table->allocator, contents, size ? size : 1);
+    return err;
+}
+
+uint64_t skip_export_framed_size(void* cfg, int include_schema) {
+    uint64_t body_size = sizeof(uint64_t);
+    if (include_schema) {
+        body_size += skip_get_export_header_body_size(cfg);
+    }
+    return skip_get_header_export_size() + body_size + skip_get_data_size(cfg);
+}
+
+int skip_export_framed(void* cfg, void* data_buffer, uint64_t data_size, void* framed_buffer, uint64_t framed_size, int include_schema) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    uint64_t header_size = skip_get_header_export_size();
+    uint64_t table_size = include_schema ? skip_get_export_header_body_size(cfg) : 0;
+
+    if (framed_size < header_size + sizeof(uint64_t) + table_size + data_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t fingerprint;
+    int err = skip_load_fingerprint(config, &fingerprint);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    err = skip_write_header(config, (char*)framed_buffer, header_size, sizeof(uint64_t) + table_size, data_size, SKIP_HEADER_FLAG_FINGERPRINT);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    if (skip_get_system_endian() != config->endian) {
+        fingerprint = swap_uint64(fingerprint);
+    }
+
+    uint8_t* pos = (uint8_t*)framed_buffer + header_size;
+    memcpy(pos, &fingerprint, sizeof(uint64_t));
+    pos += sizeof(uint64_t);
+
+    if (include_schema) {
+        skip_export_header_body(cfg, (char*)pos, table_size);
+        pos += table_size;
+    }
+
+    memcpy(pos, data_buffer, data_size);
+
+    return SKIP_SUCCESS;
+}
+
+static int skip_parse_framed(void* buffer, uint64_t buffer_size, SkipHeader* header, uint64_t* out_fingerprint) {
+    int err = skip_parse_header(buffer, buffer_size, header);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint64_t header_size = skip_get_header_export_size();
+    if (!(header->reserved[1] & SKIP_HEADER_FLAG_FINGERPRINT) || header->body_size < sizeof(uint64_t)) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (header->body_size > buffer_size - header_size || header->data_size > buffer_size - header_size - header->body_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t fingerprint;
+    memcpy(&fingerprint, (uint8_t*)buffer + header_size, sizeof(uint64_t));
+    if (skip_get_system_endian() != header->endian) {
+        fingerprint = swap_uint64(fingerprint);
+    }
+    *out_fingerprint = fingerprint;
+
+    return SKIP_SUCCESS;
+}
+
+int skip_get_framed_fingerprint(void* buffer, uint64_t buffer_size, uint64_t* out_fingerprint) {
+    if (!buffer || !out_fingerprint) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    SkipHeader header;
+    return skip_parse_framed(buffer, buffer_size, &header, out_fingerprint);
+}
+
+int skip_import_framed(void* cache, void** out_cfg, void* buffer, uint64_t buffer_size, void** out_data) {
+    if (!cache || !out_cfg || !buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    *out_cfg = NULL;
+
+    SkipHeader header;
+    uint64_t fingerprint;
+    int err = skip_parse_framed(buffer, buffer_size, &header, &fingerprint);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint64_t header_size = skip_get_header_export_size();
+    const char* table = (const char*)buffer + header_size + sizeof(uint64_t);
+    uint64_t table_size = header.body_size - sizeof(uint64_t);
+
+    void* cfg = NULL;
+    if (table_size > 0) {
+        // The first frame of a schema carries its table; intern it so later
+        // frames can be resolved by fingerprint alone.
+        err = skip_config_cache_import_header_body(cache, &cfg, header.endian, header.reserved[0], table, table_size);
+        if (err == SKIP_SUCCESS && skip_get_schema_fingerprint(cfg) != fingerprint) {
+            skip_free_cfg(cfg);
+            err = SKIP_ERROR_INVALID_CONFIG;
+        }
+    } else {
+        err = skip_config_cache_find(cache, fingerprint, &cfg);
+    }
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    if (skip_get_data_size(cfg) > header.data_size) {
+        skip_free_cfg(cfg);
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+
+    *out_cfg = cfg;
+    if (out_data) {
+        *out_data = (uint8_t*)buffer + header_size + header.body_size;
+    }
+
+    return SKIP_SUCCESS;
+}
+
+int skip_view_init(SkipView* view, void* cache, void* cfg, void* data_buffer, uint64_t data_size) {
+    if (!view || !cfg || !data_buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (data_size < skip_get_data_size(cfg)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    view->cache = cache;
+    view->cfg = cfg;
+    view->table = NULL;
+    view->table_size = 0;
+    view->data = data_buffer;
+    view->data_size = data_size;
+    view->endian = skip_get_cfg_endian(cfg);
+    view->owns_cfg = 0;
+
+    return SKIP_SUCCESS;
+}
+
+void* skip_view_get_cfg(SkipView* view) {
+    if (!view) {
+        return NULL;
+    }
+    if (view->cfg) {
+        return view->cfg;
+    }
+
+    // The type table of a child view is parsed on first access. With a
+    // cache, every later child with the same schema shares the config.
+    void* cfg = NULL;
+    if (view->cache) {
+        if (skip_config_cache_import_header_body(view->cache, &cfg, view->endian, SKIP_LAYOUT_ROWS, (const char*)view->table, view->table_size) != SKIP_SUCCESS) {
+            return NULL;
+        }
+    } else {
+        cfg = skip_create_base_config();
+        if (!cfg) {
+            return NULL;
+        }
+        skip_set_endian_value_cfg(cfg, view->endian);
+        if (skip_import_header_body(cfg, (const char*)view->table, view->table_size) != SKIP_SUCCESS) {
+            skip_free_cfg(cfg);
+            return NULL;
+        }
+    }
+
+    if (skip_get_data_size(cfg) > view->data_size) {
+        skip_free_cfg(cfg);
+        return NULL;
+    }
+
+    view->cfg = cfg;
+    view->owns_cfg = 1;
+    return cfg;
+}
+
+int skip_view_get_child(SkipView* view, uint64_t index, SkipView* out_child) {
+    if (!view || !out_child) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    SkipConfig* config = (SkipConfig*)skip_view_get_cfg(view);
+    if (!config) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (index >= config->types_size) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+    if (config->types[index].type_code != skip_nest) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t* nest = (uint8_t*)view->data + config->offsets[index];
+    uint64_t nest_size = config->offsets[index + 1] - config->offsets[index];
+    if (nest_size < sizeof(uint64_t)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t meta_size;
+    memcpy(&meta_size, nest, sizeof(uint64_t));
+    if (skip_get_system_endian() != view->endian) {
+        meta_size = swap_uint64(meta_size);
+    }
+    if (meta_size > nest_size - sizeof(uint64_t)) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    out_child->cache = view->cache;
+    out_child->cfg = NULL;
+    out_child->table = nest + sizeof(uint64_t);
+    out_child->table_size = meta_size;
+    out_child->data = nest + sizeof(uint64_t) + meta_size;
+    out_child->data_size = nest_size - sizeof(uint64_t) - meta_size;
+    out_child->endian = view->endian;
+    out_child->owns_cfg = 0;
+
+    return SKIP_SUCCESS;
+}
+
+void* skip_view_get_index_ptr(SkipView* view, uint64_t index, uint64_t* out_size) {
+    SkipConfig* config = (SkipConfig*)skip_view_get_cfg(view);
+    if (!config || index >= config->types_size) {
+        return NULL;
+    }
+    if (out_size) {
+        *out_size = config->offsets[index + 1] - config->offsets[index];
+    }
+    return (uint8_t*)view->data + config->offsets[index];
+}
+
+int skip_view_read_index(SkipView* view, uint64_t index, void* value) {
+    void* cfg = skip_view_get_cfg(view);
+    if (!cfg) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    return skip_read_index_from_buffer(cfg, view->data, view->data_size, value, index);
+}
+
+int skip_view_release(SkipView* view) {
+    if (view && view->owns_cfg) {
+        skip_free_cfg(view->cfg);
+        view->cfg = NULL;
+        view->owns_cfg = 0;
+    }
+    return SKIP_SUCCESS;
+}
+
+// A variable-length field holds one (offset, length) slot per element.
+// The bytes live in a heap that starts right after the fixed fields;
+// offsets are relative to the start of the heap. For strings and bytes the
+// length is in bytes, for dynamic arrays it is the number of elements.
+static int skip_get_var_slot(SkipConfig* config, uint64_t index, uint64_t element, uint8_t** out_slot, void* buffer, uint64_t buffer_size) {
+    if (index >= config->types_size || element >= config->types[index].count) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+    if (skip_get_var_element_size(config->types[index].type_code) == 0) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (skip_get_data_size(config) > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *out_slot = (uint8_t*)buffer + config->offsets[index] + element * SKIP_VAR_SLOT_SIZE;
+    return SKIP_SUCCESS;
+}
+
+static void skip_load_var_slot(SkipConfig* config, const uint8_t* slot, uint64_t* out_offset, uint64_t* out_length) {
+    uint64_t entry[2];
+    memcpy(entry, slot, SKIP_VAR_SLOT_SIZE);
+    if (skip_get_system_endian() != config->endian) {
+        entry[0] = swap_uint64(entry[0]);
+        entry[1] = swap_uint64(entry[1]);
+    }
+    *out_offset = entry[0];
+    *out_length = entry[1];
+}
+
+static SkipSwapKernel skip_var_element_kernel(SkipConfig* config, uint64_t element_size) {
+    if (element_size == 1 || skip_get_system_endian() == config->endian) {
+        return skip_copy_kernel;
+    }
+    return skip_select_swap_kernel(element_size, skip_get_simd_level());
+}
+
+int skip_write_var_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t* heap_used, uint64_t index, uint64_t element, const void* value, uint64_t length) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || !heap_used || (!value && length > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t* slot;
+    int err = skip_get_var_slot(config, index, element, &slot, buffer, buffer_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    int32_t type_code = config->types[index].type_code;
+    uint64_t element_size = skip_get_var_element_size(type_code);
+    if (length > UINT64_MAX / element_size - 1) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Strings keep a terminating zero in the heap so views can be used as
+    // C strings; the stored length does not include it.
+    uint64_t bytes = length * element_size;
+    uint64_t stored = bytes + (type_code == skip_string ? 1 : 0);
+    uint64_t heap_start = skip_get_data_size(config);
+    if (stored > buffer_size - heap_start || *heap_used > buffer_size - heap_start - stored) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* dst = (uint8_t*)buffer + heap_start + *heap_used;
+    skip_var_element_kernel(config, element_size)(dst, (const uint8_t*)value, bytes);
+    if (stored > bytes) {
+        dst[bytes] = 0;
+    }
+
+    uint64_t entry[2] = {*heap_used, length};
+    if (skip_get_system_endian() != config->endian) {
+        entry[0] = swap_uint64(entry[0]);
+        entry[1] = swap_uint64(entry[1]);
+    }
+    memcpy(slot, entry, SKIP_VAR_SLOT_SIZE);
+
+    *heap_used += stored;
+    return SKIP_SUCCESS;
+}
+
+static int skip_locate_var_element(SkipConfig* config, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t element, uint8_t** out_data, uint64_t* out_length) {
+    uint8_t* slot;
+    int err = skip_get_var_slot(config, index, element, &slot, buffer, buffer_size);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint64_t offset, length;
+    skip_load_var_slot(config, slot, &offset, &length);
+
+    uint64_t element_size = skip_get_var_element_size(config->types[index].type_code);
+    uint64_t heap_start = skip_get_data_size(config);
+    uint64_t heap_size = buffer_size - heap_start;
+    if (offset > heap_size || length > (heap_size - offset) / element_size) {
+        return SKIP_ERROR_OUT_OF_BOUNDS;
+    }
+
+    *out_data = (uint8_t*)buffer + heap_start + offset;
+    *out_length = length;
+    return SKIP_SUCCESS;
+}
+
+int skip_read_var_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t element, SkipIoVec* out) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || !out) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t* data;
+    uint64_t length;
+    int err = skip_locate_var_element(config, buffer, buffer_size, index, element, &data, &length);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    out->base = data;
+    out->len = length * skip_get_var_element_size(config->types[index].type_code);
+    return SKIP_SUCCESS;
+}
+
+int skip_read_array_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t element, void* values, uint64_t capacity, uint64_t* out_count) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer || (!values && capacity > 0)) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint8_t* data;
+    uint64_t count;
+    int err = skip_locate_var_element(config, buffer, buffer_size, index, element, &data, &count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+    if (out_count) {
+        *out_count = count;
+    }
+    if (count > capacity) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint64_t element_size = skip_get_var_element_size(config->types[index].type_code);
+    skip_var_element_kernel(config, element_size)((uint8_t*)values, data, count * element_size);
+    return SKIP_SUCCESS;
+}
+
+// In-place byte order conversion runs in two passes. The first checks every
+// heap slot, nested table and nesting depth, and imports each nested table
+// in walk order; only if all of that succeeds does the second pass touch the
+// buffer, so an error leaves it unchanged. The second pass converts heap
+// arrays and nested blobs while their slots and size prefixes are still in
+// the old order, then swaps the fixed fields in runs of equal element size.
+// Byte-sized fields are never touched. Writers never share heap ranges
+// between slots, so every heap element is swapped exactly once.
+#define SKIP_MAX_NEST_DEPTH 64
+
+typedef struct {
+    SkipConfig** nests;
+    uint64_t size;
+    uint64_t capacity;
+    uint64_t next;
+    const SkipAllocator* allocator;
+} SkipConvertPlan;
+
+static void skip_free_convert_plan(SkipConvertPlan* plan) {
+    for (uint64_t i = 0; i < plan->size; ++i) {
+        skip_free_cfg(plan->nests[i]);
+    }
+    skip_mem_free(plan->allocator, plan->nests, plan->capacity * sizeof(SkipConfig*));
+}
+
+static int skip_convert_plan_push(SkipConvertPlan* plan, SkipConfig* child) {
+    if (plan->size == plan->capacity) {
+        uint64_t new_cap = plan->capacity ? plan->capacity * 2 : 4;
+        SkipConfig** nests = (SkipConfig**)skip_mem_alloc(plan->allocator, new_cap * sizeof(SkipConfig*));
+        if (!nests) {
+            return SKIP_ERROR_ALLOCATION_FAILED;
+        }
+        if (plan->nests) {
+            memcpy(nests, plan->nests, plan->size * sizeof(SkipConfig*));
+            skip_mem_free(plan->allocator, plan->nests, plan->capacity * sizeof(SkipConfig*));
+        }
+        plan->nests = nests;
+        plan->capacity = new_cap;
+    }
+    plan->nests[plan->size++] = child;
+    return SKIP_SUCCESS;
+}
+
+static uint64_t skip_load_nest_meta_size(SkipConfig* parent, const uint8_t* nest) {
+    uint64_t meta_size;
+    memcpy(&meta_size, nest, sizeof(uint64_t));
+    if (skip_get_system_endian() != parent->endian) {
+        meta_size = swap_uint64(meta_size);
+    }
+    return meta_size;
+}
+
+static int skip_check_endian_data(SkipConfig* config, uint8_t* buffer, uint64_t buffer_size, uint64_t depth, SkipConvertPlan* plan) {
+    if (depth > SKIP_MAX_NEST_DEPTH) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (skip_get_data_size(config) > buffer_size) {
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        int32_t type_code = config->types[i].type_code;
+        if (skip_get_var_element_size(type_code) > 1) {
+            for (uint64_t element = 0; element < config->types[i].count; ++element) {
+                uint8_t* data;
+                uint64_t count;
+                int err = skip_locate_var_element(config, buffer, buffer_size, i, element, &data, &count);
+                if (err != SKIP_SUCCESS) {
+                    return err;
+                }
+            }
+        } else if (type_code == skip_nest) {
+            uint8_t* nest = buffer + config->offsets[i];
+            uint64_t nest_size = config->offsets[i + 1] - config->offsets[i];
+            if (nest_size == 0) {
+                continue;
+            }
+            if (nest_size < sizeof(uint64_t)) {
+                return SKIP_ERROR_BUFFER_TOO_SMALL;
+            }
+            uint64_t meta_size = skip_load_nest_meta_size(config, nest);
+            if (meta_size > nest_size - sizeof(uint64_t)) {
+                return SKIP_ERROR_BUFFER_TOO_SMALL;
+            }
+
+            SkipConfig* child = (SkipConfig*)skip_create_base_config();
+            if (!child) {
+                return SKIP_ERROR_ALLOCATION_FAILED;
+            }
+            skip_set_endian_value_cfg(child, config->endian);
+            int err = skip_import_header_body(child, (const char*)nest + sizeof(uint64_t), meta_size);
+            // The table is rewritten in place, so it must re-encode to
+            // exactly the same size.
+            if (err == SKIP_SUCCESS && skip_get_export_header_body_size(child) != meta_size) {
+                err = SKIP_ERROR_INVALID_CONFIG;
+            }
+            if (err == SKIP_SUCCESS) {
+                err = skip_convert_plan_push(plan, child);
+            }
+            if (err != SKIP_SUCCESS) {
+                skip_free_cfg(child);
+                return err;
+            }
+
+            uint8_t* data = nest + sizeof(uint64_t) + meta_size;
+            err = skip_check_endian_data(child, data, nest_size - sizeof(uint64_t) - meta_size, depth + 1, plan);
+            if (err != SKIP_SUCCESS) {
+                return err;
+            }
+        }
+    }
+
+    return SKIP_SUCCESS;
+}
+
+static void skip_apply_endian_data(SkipConfig* config, uint8_t* buffer, uint64_t buffer_size, int target_endian, SkipConvertPlan* plan) {
+    int simd_level = skip_get_simd_level();
+    for (uint64_t i = 0; i < config->types_size; ++i) {
+        int32_t type_code = config->types[i].type_code;
+        uint64_t element_size = skip_get_var_element_size(type_code);
+        if (element_size > 1) {
+            SkipSwapKernel kernel = skip_select_swap_kernel(element_size, simd_level);
+            for (uint64_t element = 0; element < config->types[i].count; ++element) {
+                uint8_t* data;
+                uint64_t count;
+                skip_locate_var_element(config, buffer, buffer_size, i, element, &data, &count);
+                kernel(data, data, count * element_size);
+            }
+        } else if (type_code == skip_nest) {
+            uint8_t* nest = buffer + config->offsets[i];
+            uint64_t nest_size = config->offsets[i + 1] - config->offsets[i];
+            if (nest_size == 0) {
+                continue;
+            }
+
+            SkipConfig* child = plan->nests[plan->next++];
+            uint64_t meta_size = skip_load_nest_meta_size(config, nest);
+            char* table = (char*)nest + sizeof(uint64_t);
+            skip_apply_endian_data(child, (uint8_t*)table + meta_size, nest_size - sizeof(uint64_t) - meta_size, target_endian, plan);
+            skip_set_endian_value_cfg(child, target_endian);
+            skip_export_header_body(child, table, meta_size);
+
+            if (skip_get_system_endian() != target_endian) {
+                meta_size = swap_uint64(meta_size);
+            }
+            memcpy(nest, &meta_size, sizeof(uint64_t));
+        }
+    }
+
+    uint64_t i = 0;
+    while (i < config->types_size) {
+        uint64_t unit = skip_get_swap_unit(config->types[i].type_code);
+        uint64_t end = i + 1;
+        while (end < config->types_size && skip_get_swap_unit(config->types[end].type_code) == unit) {
+            ++end;
+        }
+        if (unit > 1) {
+            uint8_t* run = buffer + config->offsets[i];
+            skip_select_swap_kernel(unit, simd_level)(run, run, config->offsets[end] - config->offsets[i]);
+        }
+        i = end;
+    }
+}
+
+static int skip_convert_endian_data(SkipConfig* config, uint8_t* buffer, uint64_t buffer_size, int target_endian) {
+    if (config->endian == target_endian) {
+        return SKIP_SUCCESS;
+    }
+
+    SkipConvertPlan plan;
+    memset(&plan, 0, sizeof(plan));
+    plan.allocator = &config->allocator;
+    int err = skip_check_endian_data(config, buffer, buffer_size, 0, &plan);
+    if (err == SKIP_SUCCESS) {
+        skip_apply_endian_data(config, buffer, buffer_size, target_endian, &plan);
+    }
+    skip_free_convert_plan(&plan);
+    return err;
+}
+
+int skip_convert_endian_inplace(void* cfg, void* buffer, uint64_t buffer_size, int target_endian) {
+    SkipConfig* config = (SkipConfig*)cfg;
+    if (!config || !buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (target_endian != SKIP_BIG_ENDIAN && target_endian != SKIP_LITTLE_ENDIAN) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    return skip_convert_endian_data(config, (uint8_t*)buffer, buffer_size, target_endian);
+}
+
+int skip_convert_standalone_endian_inplace(void* buffer, uint64_t buffer_size, int target_endian) {
+    if (!buffer) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+    if (target_endian != SKIP_BIG_ENDIAN && target_endian != SKIP_LITTLE_ENDIAN) {
+        return SKIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    uint64_t body_size;
+    uint64_t data_size;
+    SkipConfig* config = (SkipConfig*)skip_import_header(buffer, buffer_size, &body_size, &data_size);
+    if (!config) {
+        return SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (body_size > buffer_size - SKIP_HEADER_SIZE || data_size > buffer_size - SKIP_HEADER_SIZE - body_size) {
+        skip_free_cfg(config);
+        return SKIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // The table is checked before the data is converted, so a table that
+    // cannot be rewritten in place leaves the buffer unchanged.
+    char* table = (char*)buffer + SKIP_HEADER_SIZE;
+    int err = skip_import_header_body(config, table, body_size);
+    if (err == SKIP_SUCCESS && skip_get_export_header_body_size(config) != body_size) {
+        err = SKIP_ERROR_INVALID_CONFIG;
+    }
+    if (err == SKIP_SUCCESS) {
+        err = skip_convert_endian_data(config, (uint8_t*)table + body_size, data_size, target_endian);
+    }
+    if (err == SKIP_SUCCESS && config->endian != target_endian) {
+        skip_set_endian_value_cfg(config, target_endian);
+        skip_export_header_body(config, table, body_size);
+        ((uint8_t*)buffer)[SKIP_HEADER_ENDIAN_OFFSET] = (uint8_t)target_endian;
+    }
+    skip_free_cfg(config);
+    return err;
+}
+
+// Parallel transfers split the data body into fixed-size chunks. Every
+// participant starts on its own contiguous block of chunks and, once that
+// is done, steals the remaining chunks of the other blocks. Chunks cover
+// disjoint byte ranges of the buffer, so no locking is needed.
+#define SKIP_PARALLEL_CHUNK (256 * 1024)
+
+typedef struct {
+    uint64_t next;
+    uint64_t end;
+    uint8_t padding[48];
+} SkipWorkRange;
+
+typedef struct SkipThreadPool {
+    SkipMutex lock;
+    SkipCond wake;
+    SkipCond idle;
+    SkipMutex job_lock;
+
+    SkipThread* threads;
+    uint64_t thread_count;
+    SkipWorkRange* ranges;
+
+    SkipConfig* config;
+    uint8_t* buffer;
+    const SkipIoVec* fields;
+    int to_buffer;
+
+    uint64_t generation;
+    uint64_t active;
+    int stop;
+    SkipAllocator allocator;
+} SkipThreadPool;
+
+typedef struct {
+    SkipThreadPool* pool;
+    uint64_t index;
+} SkipWorkerArgs;
+
+// Rounds a buffer position inside a field up to the next element boundary,
+// so neighbouring chunks split a field between whole elements.
+static uint64_t skip_align_in_field(uint64_t pos, uint64_t field_start, uint64_t unit) {
+    if (pos <= field_start) {
+        return field_start;
+    }
+    return field_start + (pos - field_start + unit - 1) / unit * unit;
+}
+
+static void skip_transfer_range(SkipConfig* config, uint8_t* base, const SkipIoVec* fields, int to_buffer, uint64_t begin, uint64_t end) {
+    // First field that ends after begin.
+    uint64_t lo = 0, hi = config->types_size;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (config->offsets[mid + 1] <= begin) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (uint64_t i = lo; i < config->types_size && config->offsets[i] < end; ++i) {
+        if (!fields[i].base) continue;
+
+        SkipFieldPlan scratch;
+        const SkipFieldPlan* field = skip_get_field_plan(config, i, &scratch);
+        uint64_t field_end = field->offset + field->byte_len;
+        uint64_t unit = field->type_size ? field->type_size : 1;
+
+        uint64_t from = skip_align_in_field(begin, field->offset, unit);
+        uint64_t to = end >= field_end ? field_end : skip_align_in_field(end, field->offset, unit);
+        if (to > field_end) to = field_end;
+        if (from >= to) continue;
+
+        uint8_t* field_data = (uint8_t*)fields[i].base + (from - field->offset);
+        if (to_buffer) {
+            field->kernel(base + from, field_data, to - from);
+        } else {
+            field->kernel(field_data, base + from, to - from);
+        }
+    }
+}
+
+static void skip_pool_work(SkipThreadPool* pool, uint64_t self) {
+    uint64_t participants = pool->thread_count;
+    for (uint64_t k = 0; k < participants; ++k) {
+        SkipWorkRange* range = &pool->ranges[(self + k) % participants];
+        for (;;) {
+            uint64_t chunk = skip_atomic_fetch_add64(&range->next, 1);
+            if (chunk >= range->end) break;
+            skip_transfer_range(pool->config, pool->buffer, pool->fields, pool->to_buffer,
+                                chunk * SKIP_PARALLEL_CHUNK, (chunk + 1) * SKIP_PARALLEL_CHUNK);
+        }
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI skip_pool_worker(LPVOID arg)
+#else
+static void* skip_pool_worker(void* arg)
+#endif
+{
+    SkipWorkerArgs args = *(SkipWorkerArgs*)arg;
+    SkipThreadPool* pool = args.pool;
+    skip_mem_free(&pool->allocator, arg, sizeof(SkipWorkerArgs));
+    uint64_t seen = 0;
+
+    for (;;) {
+        skip_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->generation == seen) {
+            skip_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop) {
+            skip_mutex_unlock(&pool->lock);
+            break;
+        }
+        seen = pool->generation;
+        skip_mutex_unlock(&pool->lock);
+
+        skip_pool_work(pool, args.index);
+
+        skip_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            skip_cond_broadcast(&pool->idle);
+        }
+        skip_mutex_unlock(&pool->lock);
+    }
+
+    return 0;
+}
+
+static uint64_t skip_get_cpu_count() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint64_t)count : 1;
+#endif
+}
+
+static void skip_stop_pool_threads(SkipThreadPool* pool, uint64_t started) {
+    skip_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    skip_cond_broadcast(&pool->wake);
+    skip_mutex_unlock(&pool->lock);
+
+    for (uint64_t i = 0; i < started; ++i) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+}
+
+// Releases a pool whose threads have already been joined.
+static void skip_release_pool(SkipThreadPool* pool) {
+    SkipAllocator allocator = pool->allocator;
+    skip_mem_free(&allocator, pool->threads, pool->thread_count * sizeof(SkipThread));
+    skip_mem_free(&allocator, pool->ranges, pool->thread_count * sizeof(SkipWorkRange));
+    skip_cond_destroy(&pool->wake);
+    skip_cond_destroy(&pool->idle);
+    skip_mutex_destroy(&pool->lock);
+    skip_mutex_destroy(&pool->job_lock);
+    skip_mem_free(&allocator, pool, sizeof(SkipThreadPool));
+}
+
+int skip_free_thread_pool(void* pool) {
+    if (pool) {
+        SkipThreadPool* workers = (SkipThreadPool*)pool;
+        skip_stop_pool_threads(workers, workers->thread_count - 1);
+        skip_release_pool(workers);
+    }
+    return SKIP_SUCCESS;
+}
+
+void* skip_create_thread_pool(uint64_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = skip_get_cpu_count();
+    }
+
+    SkipAllocator allocator = skip_global_allocator;
+    SkipThreadPool* pool = (SkipThreadPool*)skip_mem_alloc(&allocator, sizeof(SkipThreadPool));
+    if (!pool) return NULL;
+    memset(pool, 0, sizeof(SkipThreadPool));
+    pool->allocator = allocator;
+
+    // The calling thread is one of the participants.
+    pool->thread_count = thread_count;
+    pool->threads = (SkipThread*)skip_mem_alloc(&allocator, thread_count * sizeof(SkipThread));
+    pool->ranges = (SkipWorkRange*)skip_mem_alloc(&allocator, thread_count * sizeof(SkipWorkRange));
+    if (!pool->threads || !pool->ranges) {
+        skip_mem_free(&allocator, pool->threads, thread_count * sizeof(SkipThread));
+        skip_mem_free(&allocator, pool->ranges, thread_count * sizeof(SkipWorkRange));
+        skip_mem_free(&allocator, pool, sizeof(SkipThreadPool));
+        return NULL;
+    }
+    memset(pool->ranges, 0, (size_t)(thread_count * sizeof(SkipWorkRange)));
+
+    skip_mutex_init(&pool->lock);
+    skip_mutex_init(&pool->job_lock);
+    skip_cond_init(&pool->wake);
+    skip_cond_init(&pool->idle);
+
+    for (uint64_t i = 0; i + 1 < thread_count; ++i) {
+        SkipWorkerArgs* args = (SkipWorkerArgs*)skip_mem_alloc(&allocator, sizeof(SkipWorkerArgs));
+        int started = 0;
+        if (args) {
+            args->pool = pool;
+            args->index = i + 1;
+#ifdef _WIN32
+            pool->threads[i] = CreateThread(NULL, 0, skip_pool_worker, args, 0, NULL);
+            started = pool->threads[i] != NULL;
+#else
+            started = pthread_create(&pool->threads[i], NULL, skip_pool_worker, args) == 0;
+#endif
+            if (!started) {
+                skip_mem_free(&allocator, args, sizeof(SkipWorkerArgs));
+            }
+        }
+        if (!started) {
+            // Only the first i workers exist; join them once and release.
+            skip_stop_pool_threads(pool, i);
+            skip_release_pool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+uint64_t skip_get_thread_pool_size(void* pool) {
+    SkipThreadPool* workers = (SkipThreadPool*)pool;
+    return workers ? workers->thread_count : 1;
+}
+
+static int skip_transfer_all_parallel(SkipThreadPool* pool, SkipConfig* config, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count, int to_buffer) {
+    int err = skip_check_transfer(config, buffer, buffer_size, fields, field_count);
+    if (err != SKIP_SUCCESS) {
+        return err;
+    }
+
+    uint64_t chunks = (skip_get_data_size(config) + SKIP_PARALLEL_CHUNK - 1) / SKIP_PARALLEL_CHUNK;
+    if (!pool || pool->thread_count < 2 || chunks < 2) {
+        return skip_transfer_all(config, buffer, buffer_size, fields, field_count, to_buffer);
+    }
+
+    // One job at a time per pool; concurrent callers queue up here.
+    skip_mutex_lock(&pool->job_lock);
+
+    uint64_t participants = pool->thread_count;
+    for (uint64_t t = 0; t < participants; ++t) {
+        pool->ranges[t].next = chunks * t / participants;
+        pool->ranges[t].end = chunks * (t + 1) / participants;
+    }
+    pool->config = config;
+    pool->buffer = (uint8_t*)buffer;
+    pool->fields = fields;
+    pool->to_buffer = to_buffer;
+
+    skip_mutex_lock(&pool->lock);
+    pool->active = participants - 1;
+    pool->generation++;
+    skip_cond_broadcast(&pool->wake);
+    skip_mutex_unlock(&pool->lock);
+
+    skip_pool_work(pool, 0);
+
+    skip_mutex_lock(&pool->lock);
+    while (pool->active > 0) {
+        skip_cond_wait(&pool->idle, &pool->lock);
+    }
+    skip_mutex_unlock(&pool->lock);
+
+    skip_mutex_unlock(&pool->job_lock);
+    return SKIP_SUCCESS;
+}
+
+int skip_write_all_parallel(void* pool, void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count) {
+    return skip_transfer_all_parallel((SkipThreadPool*)pool, (SkipConfig*)cfg, buffer, buffer_size, fields, field_count, 1);
+}
+
+int skip_read_all_parallel(void* pool, void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count) {
+    return skip_transfer_all_parallel((SkipThreadPool*)pool, (SkipConfig*)cfg, buffer, buffer_size, fields, field_count, 0);
 }
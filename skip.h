@@ -13,6 +13,22 @@ enum SkipEndian {
     SKIP_LITTLE_ENDIAN = 1
 };
 
+enum SkipHeaderFormat {
+    SKIP_HEADER_FORMAT_FIXED = 0,
+    SKIP_HEADER_FORMAT_COMPACT = 1
+};
+
+enum SkipRecordLayout {
+    SKIP_LAYOUT_ROWS = 0,
+    SKIP_LAYOUT_COLUMNS = 1
+};
+
+enum SkipAccessAdvice {
+    SKIP_ACCESS_NORMAL = 0,
+    SKIP_ACCESS_SEQUENTIAL = 1,
+    SKIP_ACCESS_RANDOM = 2
+};
+
 enum SkipError {
     SKIP_SUCCESS = 0,
     SKIP_ERROR_INVALID_ARGUMENT = -1,
@@ -22,6 +38,10 @@ enum SkipError {
     SKIP_ERROR_INVALID_CONFIG = -5,
     SKIP_ERROR_FAILED_TO_CREATE_HEADER_CFG = -6,
     SKIP_ERROR_INIT_THE_SKIP_FIRST = -7,
+    SKIP_ERROR_IO_FAILED = -8,
+    SKIP_ERROR_CONFIG_IMMUTABLE = -9,
+    SKIP_ERROR_UNKNOWN_SCHEMA = -10,
+    SKIP_ERROR_UNKNOWN_FIELD = -11,
 };
 
 enum SkipDataTypeCode {
@@ -37,6 +57,17 @@ enum SkipDataTypeCode {
     skip_float64 = 9,
     skip_char = 10,
     skip_nest = 11,
+    skip_string = 12,
+    skip_bytes = 13,
+    skip_array = 0x100,
+};
+
+enum SkipSimdLevel {
+    SKIP_SIMD_AUTO = -1,
+    SKIP_SIMD_SCALAR = 0,
+    SKIP_SIMD_SSE2 = 1,
+    SKIP_SIMD_AVX2 = 2,
+    SKIP_SIMD_AVX512 = 3,
 };
 
 typedef struct SkipInternalType {
@@ -44,20 +75,87 @@ typedef struct SkipInternalType {
     uint64_t count;
 } SkipInternalType;
 
+typedef struct SkipAllocator {
+    void* (*alloc)(void* user, uint64_t size);
+    void* (*realloc)(void* user, void* ptr, uint64_t old_size, uint64_t new_size);
+    void (*free)(void* user, void* ptr, uint64_t size);
+    void* user;
+} SkipAllocator;
+
+typedef int (*SkipSinkFn)(void* user, const void* data, uint64_t size);
+
+typedef int (*SkipFieldFn)(void* user, uint64_t index, uint64_t byte_offset, const void* data, uint64_t size);
+
+typedef struct SkipStructMember {
+    uint64_t index;
+    uint64_t offset;
+} SkipStructMember;
+
+typedef struct SkipIoVec {
+    void* base;
+    uint64_t len;
+} SkipIoVec;
+
+typedef struct SkipFieldRange {
+    uint64_t index;
+    uint64_t offset;
+    uint64_t length;
+    void* value;
+} SkipFieldRange;
+
+typedef struct SkipView {
+    void* cache;
+    void* cfg;
+    const void* table;
+    uint64_t table_size;
+    void* data;
+    uint64_t data_size;
+    int endian;
+    int owns_cfg;
+} SkipView;
+
 int skip_init();
 
 int skip_free();
 
 void* skip_create_base_config();
 
+void* skip_create_base_config_with_allocator(const SkipAllocator* allocator);
+
+int skip_set_allocator(const SkipAllocator* allocator);
+
+void* skip_create_arena(uint64_t capacity);
+
+int skip_get_arena_allocator(void* arena, SkipAllocator* out_allocator);
+
+uint64_t skip_get_arena_used(void* arena);
+
+int skip_reset_arena(void* arena);
+
+int skip_free_arena(void* arena);
+
 int skip_push_type_to_config(void* cfg , int32_t type_code , uint64_t len);
 
 int skip_pop_type_from_config(void* cfg);
 
 SkipInternalType* skip_get_type_at_index(void* cfg , uint64_t index);
 
+int skip_push_named_type_to_config(void* cfg, const char* name, int32_t type_code, uint64_t count);
+
+int skip_set_field_name(void* cfg, uint64_t index, const char* name);
+
+const char* skip_get_field_name(void* cfg, uint64_t index);
+
+int64_t skip_field_index(void* cfg, const char* name);
+
+int64_t skip_field_index_n(void* cfg, const char* name, uint64_t length);
+
 int skip_free_cfg(void* cfg);
 
+int skip_compile_config(void* cfg);
+
+int skip_is_config_compiled(void* cfg);
+
 uint64_t skip_get_data_size(void* cfg);
 
 uint64_t skip_get_datatype_size(int32_t type_code);
@@ -66,6 +164,64 @@ int skip_write_index_to_buffer(void* cfg, void* buffer, uint64_t buffer_size, vo
 
 int skip_read_index_from_buffer(void* cfg, void* buffer, uint64_t buffer_size, void* value, uint64_t index);
 
+int skip_write_index_range(void* cfg, void* buffer, uint64_t buffer_size, const void* values, uint64_t index, uint64_t first, uint64_t count);
+
+int skip_read_index_range(void* cfg, void* buffer, uint64_t buffer_size, void* values, uint64_t index, uint64_t first, uint64_t count);
+
+int skip_gather_index_elements(void* cfg, void* buffer, uint64_t buffer_size, void* values, uint64_t index, const uint64_t* elements, uint64_t element_count);
+
+int skip_write_all(void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count);
+
+int skip_read_all(void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count);
+
+void* skip_create_thread_pool(uint64_t thread_count);
+
+int skip_free_thread_pool(void* pool);
+
+uint64_t skip_get_thread_pool_size(void* pool);
+
+int skip_write_all_parallel(void* pool, void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count);
+
+int skip_read_all_parallel(void* pool, void* cfg, void* buffer, uint64_t buffer_size, const SkipIoVec* fields, uint64_t field_count);
+
+void* skip_create_struct_map(void* cfg, const SkipStructMember* members, uint64_t member_count, uint64_t struct_size);
+
+int skip_free_struct_map(void* map);
+
+uint64_t skip_get_struct_map_record_size(void* map);
+
+int skip_struct_read(void* map, void* buffer, uint64_t buffer_size, void* structs, uint64_t struct_count);
+
+int skip_struct_write(void* map, void* buffer, uint64_t buffer_size, const void* structs, uint64_t struct_count);
+
+int skip_create_projection(void** out_projection, void* writer_cfg, void* reader_cfg);
+
+int skip_free_projection(void* projection);
+
+int64_t skip_get_projection_source(void* projection, uint64_t reader_index);
+
+int skip_set_projection_default(void* projection, uint64_t reader_index, const void* value);
+
+uint64_t skip_get_projected_size(void* projection, uint64_t src_size);
+
+int skip_project(void* projection, const void* src, uint64_t src_size, void* dst, uint64_t dst_size);
+
+uint64_t skip_get_record_array_size(void* cfg, uint64_t record_count);
+
+int skip_init_record_array(void* cfg, void* buffer, uint64_t buffer_size, uint64_t record_count);
+
+int skip_get_record_array_count(void* cfg, void* buffer, uint64_t buffer_size, uint64_t* out_count);
+
+void* skip_get_record_ptr(void* cfg, void* buffer, uint64_t buffer_size, uint64_t record_index);
+
+int skip_write_records(void* cfg, void* buffer, uint64_t buffer_size, const void* records, uint64_t first, uint64_t count);
+
+int skip_read_records(void* cfg, void* buffer, uint64_t buffer_size, void* records, uint64_t first, uint64_t count);
+
+void* skip_get_column_ptr(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index);
+
+int skip_read_record_column(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t first, uint64_t count, void* out);
+
 void* skip_get_index_ptr(void* cfg, void* buffer, uint64_t index);
 
 int skip_import_header_body(void* cfg, const char* buffer, uint64_t buffer_size);
@@ -88,12 +244,38 @@ int skip_set_endian_value_cfg(void* cfg, int endian);
 
 int skip_get_cfg_endian(void* cfg);
 
+int skip_set_record_layout_cfg(void* cfg, int layout);
+
+int skip_get_record_layout_cfg(void* cfg);
+
+int skip_set_header_format_cfg(void* cfg, int format);
+
+int skip_get_header_format_cfg(void* cfg);
+
 int skip_create_nest_buffer(void* cfg, void* final_res, uint64_t final_res_size, void* data_buffer, uint64_t data_size);
 
 int skip_get_nest_cfg(void* cfg, void* nest_base_cfg, void* nest_buffer, uint64_t nest_size);
 
 int skip_get_nested_data_buffer(void* cfg, void* nest_buffer, uint64_t nest_size, void* data_buffer, uint64_t data_size);
 
+int skip_write_var_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t* heap_used, uint64_t index, uint64_t element, const void* value, uint64_t length);
+
+int skip_read_var_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t element, SkipIoVec* out);
+
+int skip_read_array_element(void* cfg, void* buffer, uint64_t buffer_size, uint64_t index, uint64_t element, void* values, uint64_t capacity, uint64_t* out_count);
+
+int skip_view_init(SkipView* view, void* cache, void* cfg, void* data_buffer, uint64_t data_size);
+
+void* skip_view_get_cfg(SkipView* view);
+
+int skip_view_get_child(SkipView* view, uint64_t index, SkipView* out_child);
+
+void* skip_view_get_index_ptr(SkipView* view, uint64_t index, uint64_t* out_size);
+
+int skip_view_read_index(SkipView* view, uint64_t index, void* value);
+
+int skip_view_release(SkipView* view);
+
 uint64_t skip_export_standalone_size(void* cfg);
 
 
@@ -104,6 +286,90 @@ int skip_import_standalone_get_cfg(void** void_null_ptr, void* buffer, uint64_t
 
 int skip_import_standalone_get_data_buffer(void* cfg , void* buffer , uint64_t buffer_size , void* data_buffer , uint64_t data_buffer_size);
 
+void* skip_mmap_open(const char* path, int advice);
+
+int skip_mmap_close(void* file);
+
+int skip_mmap_advise(void* file, int advice);
+
+void* skip_mmap_get_cfg(void* file);
+
+void* skip_mmap_get_data_ptr(void* file, uint64_t* out_data_size);
+
+void* skip_mmap_get_index_ptr(void* file, uint64_t index);
+
+int skip_standalone_read_fields(void* cfg, const void* buffer, uint64_t buffer_size, const SkipFieldRange* ranges, uint64_t range_count);
+
+void* skip_pread_open(int fd);
+
+int skip_pread_close(void* file);
+
+void* skip_pread_get_cfg(void* file);
+
+int skip_pread_fields(void* file, const SkipFieldRange* ranges, uint64_t range_count);
+
+void* skip_create_stream_writer(void* cfg, SkipSinkFn sink, void* user, uint64_t chunk_size);
+
+int skip_stream_write_field(void* stream, uint64_t index, const void* value);
+
+int skip_stream_write_elements(void* stream, const void* values, uint64_t count);
+
+int skip_finish_stream_writer(void* stream);
+
+int skip_free_stream_writer(void* stream);
+
+int skip_fd_sink(void* user, const void* data, uint64_t size);
+
+void* skip_create_stream_reader(SkipFieldFn on_field, void* user, uint64_t chunk_size);
+
+int skip_set_stream_reader_max_table_size(void* stream, uint64_t max_size);
+
+int skip_stream_reader_feed(void* stream, const void* data, uint64_t size);
+
+void* skip_stream_reader_get_cfg(void* stream);
+
+int skip_stream_reader_is_done(void* stream);
+
+int skip_free_stream_reader(void* stream);
+
+void* skip_create_config_cache(uint64_t max_entries);
+
+int skip_free_config_cache(void* cache);
+
+int skip_config_cache_import_standalone(void* cache, void** out_cfg, void* buffer, uint64_t buffer_size);
+
+int skip_config_cache_import_header_body(void* cache, void** out_cfg, int endian, int layout, const char* buffer, uint64_t buffer_size);
+
+int skip_config_cache_get_stats(void* cache, uint64_t* out_hits, uint64_t* out_misses, uint64_t* out_entries);
+
+int skip_is_config_shared(void* cfg);
+
+uint64_t skip_get_schema_fingerprint(void* cfg);
+
+int skip_config_cache_register(void* cache, void* cfg);
+
+int skip_config_cache_find(void* cache, uint64_t fingerprint, void** out_cfg);
+
+int skip_config_cache_save_file(void* cache, const char* path);
+
+int skip_config_cache_load_file(void* cache, const char* path);
+
+uint64_t skip_export_framed_size(void* cfg, int include_schema);
+
+int skip_export_framed(void* cfg, void* data_buffer, uint64_t data_size, void* framed_buffer, uint64_t framed_size, int include_schema);
+
+int skip_get_framed_fingerprint(void* buffer, uint64_t buffer_size, uint64_t* out_fingerprint);
+
+int skip_import_framed(void* cache, void** out_cfg, void* buffer, uint64_t buffer_size, void** out_data);
+
+int skip_get_simd_level();
+
+int skip_swap_elements(void* dst, const void* src, uint64_t type_size, uint64_t count, int simd_level);
+
+int skip_convert_endian_inplace(void* cfg, void* buffer, uint64_t buffer_size, int target_endian);
+
+int skip_convert_standalone_endian_inplace(void* buffer, uint64_t buffer_size, int target_endian);
+
 #ifdef __cplusplus
 }
 #endif
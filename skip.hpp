@@ -0,0 +1,242 @@
+#ifndef SKIP_HPP
+#define SKIP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "skip.h"
+
+// Compile-time schemas over the C API. Offsets and sizes are constants and
+// each accessor is specialized per field, so a field read is a load plus an
+// optional byte swap. Buffers use the same packed layout as a SkipConfig
+// built from the same fields, see BasicSchema::create_config.
+
+namespace skip {
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr int host_endian = SKIP_BIG_ENDIAN;
+#else
+constexpr int host_endian = SKIP_LITTLE_ENDIAN;
+#endif
+
+template <typename T, int32_t Code>
+struct scalar {
+    using value_type = T;
+    static constexpr int32_t type_code = Code;
+};
+
+using i8 = scalar<int8_t, skip_int8>;
+using u8 = scalar<uint8_t, skip_uint8>;
+using i16 = scalar<int16_t, skip_int16>;
+using u16 = scalar<uint16_t, skip_uint16>;
+using i32 = scalar<int32_t, skip_int32>;
+using u32 = scalar<uint32_t, skip_uint32>;
+using i64 = scalar<int64_t, skip_int64>;
+using u64 = scalar<uint64_t, skip_uint64>;
+using f32 = scalar<float, skip_float32>;
+using f64 = scalar<double, skip_float64>;
+using ch = scalar<char, skip_char>;
+
+// A fixed-size character field, the same as ch[N].
+template <uint64_t N>
+struct chars {};
+
+namespace detail {
+
+template <typename F>
+struct is_scalar : std::false_type {};
+
+template <typename T, int32_t Code>
+struct is_scalar<scalar<T, Code>> : std::true_type {};
+
+template <typename F>
+struct field_traits {
+    static_assert(is_scalar<F>::value, "skip schema fields must be skip::scalar types, arrays of them, or skip::chars<N>");
+    using element = F;
+    static constexpr uint64_t count = 1;
+};
+
+template <typename E, std::size_t N>
+struct field_traits<E[N]> {
+    static_assert(is_scalar<E>::value, "skip schema arrays must have a skip::scalar element type");
+    using element = E;
+    static constexpr uint64_t count = N;
+};
+
+template <uint64_t N>
+struct field_traits<chars<N>> {
+    using element = ch;
+    static constexpr uint64_t count = N;
+};
+
+template <typename F>
+constexpr uint64_t field_bytes() {
+    return field_traits<F>::count * sizeof(typename field_traits<F>::element::value_type);
+}
+
+template <std::size_t Size> struct uint_of;
+template <> struct uint_of<1> { using type = uint8_t; };
+template <> struct uint_of<2> { using type = uint16_t; };
+template <> struct uint_of<4> { using type = uint32_t; };
+template <> struct uint_of<8> { using type = uint64_t; };
+
+inline uint8_t bswap(uint8_t value) { return value; }
+
+#if defined(__GNUC__) || defined(__clang__)
+inline uint16_t bswap(uint16_t value) { return __builtin_bswap16(value); }
+inline uint32_t bswap(uint32_t value) { return __builtin_bswap32(value); }
+inline uint64_t bswap(uint64_t value) { return __builtin_bswap64(value); }
+#else
+inline uint16_t bswap(uint16_t value) { return (uint16_t)((value >> 8) | (value << 8)); }
+inline uint32_t bswap(uint32_t value) {
+    return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) |
+           ((value & 0x00FF0000u) >> 8) | ((value & 0xFF000000u) >> 24);
+}
+inline uint64_t bswap(uint64_t value) {
+    return ((uint64_t)bswap((uint32_t)value) << 32) | bswap((uint32_t)(value >> 32));
+}
+#endif
+
+template <int Endian, typename T>
+inline T load(const unsigned char* pos) {
+    typename uint_of<sizeof(T)>::type bits;
+    std::memcpy(&bits, pos, sizeof(T));
+    if constexpr (Endian != host_endian) {
+        bits = bswap(bits);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+template <int Endian, typename T>
+inline void store(unsigned char* pos, T value) {
+    typename uint_of<sizeof(T)>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    if constexpr (Endian != host_endian) {
+        bits = bswap(bits);
+    }
+    std::memcpy(pos, &bits, sizeof(T));
+}
+
+} // namespace detail
+
+template <int Endian, typename... Fields>
+struct BasicSchema {
+    static_assert(Endian == SKIP_BIG_ENDIAN || Endian == SKIP_LITTLE_ENDIAN, "Endian must be SKIP_BIG_ENDIAN or SKIP_LITTLE_ENDIAN");
+
+private:
+    static constexpr uint64_t field_sizes[sizeof...(Fields) + 1] = {detail::field_bytes<Fields>()..., 0};
+
+    static constexpr uint64_t offset_of(std::size_t index) {
+        uint64_t offset = 0;
+        for (std::size_t i = 0; i < index; ++i) {
+            offset += field_sizes[i];
+        }
+        return offset;
+    }
+
+    template <std::size_t... I>
+    static int push_fields(void* cfg, std::index_sequence<I...>) {
+        int err = SKIP_SUCCESS;
+        ((err = err == SKIP_SUCCESS ? skip_push_type_to_config(cfg, type_code<I>, count<I>) : err), ...);
+        return err;
+    }
+
+    template <std::size_t... I>
+    static bool match_fields(void* cfg, std::index_sequence<I...>) {
+        return ((skip_get_type_at_index(cfg, I) &&
+                 skip_get_type_at_index(cfg, I)->type_code == type_code<I> &&
+                 skip_get_type_at_index(cfg, I)->count == count<I>) && ...);
+    }
+
+public:
+    static constexpr int endian = Endian;
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+    template <std::size_t I>
+    using field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    template <std::size_t I>
+    using value_type = typename detail::field_traits<field<I>>::element::value_type;
+
+    template <std::size_t I>
+    static constexpr int32_t type_code = detail::field_traits<field<I>>::element::type_code;
+
+    template <std::size_t I>
+    static constexpr uint64_t count = detail::field_traits<field<I>>::count;
+
+    template <std::size_t I>
+    static constexpr uint64_t offset = offset_of(I);
+
+    static constexpr uint64_t size = offset_of(sizeof...(Fields));
+
+    // Element access is unchecked, like skip_get_index_ptr; the buffer must
+    // hold at least `size` bytes and element must be below count<I>.
+    template <std::size_t I>
+    static value_type<I> get(const void* buffer, uint64_t element = 0) {
+        const unsigned char* pos = (const unsigned char*)buffer + offset<I> + element * sizeof(value_type<I>);
+        return detail::load<Endian, value_type<I>>(pos);
+    }
+
+    template <std::size_t I>
+    static void set(void* buffer, value_type<I> value) {
+        detail::store<Endian>((unsigned char*)buffer + offset<I>, value);
+    }
+
+    template <std::size_t I>
+    static void set(void* buffer, uint64_t element, value_type<I> value) {
+        detail::store<Endian>((unsigned char*)buffer + offset<I> + element * sizeof(value_type<I>), value);
+    }
+
+    template <std::size_t I>
+    static void read(const void* buffer, value_type<I>* values) {
+        for (uint64_t i = 0; i < count<I>; ++i) {
+            values[i] = get<I>(buffer, i);
+        }
+    }
+
+    template <std::size_t I>
+    static void write(void* buffer, const value_type<I>* values) {
+        for (uint64_t i = 0; i < count<I>; ++i) {
+            set<I>(buffer, i, values[i]);
+        }
+    }
+
+    // Builds the equivalent runtime config, e.g. for skip_export_standalone.
+    // Free it with skip_free_cfg.
+    static void* create_config() {
+        void* cfg = skip_create_base_config();
+        if (!cfg) {
+            return nullptr;
+        }
+
+        if (skip_set_endian_value_cfg(cfg, Endian) != SKIP_SUCCESS ||
+            push_fields(cfg, std::index_sequence_for<Fields...>{}) != SKIP_SUCCESS) {
+            skip_free_cfg(cfg);
+            return nullptr;
+        }
+
+        return cfg;
+    }
+
+    // True when cfg has exactly these fields and byte order, so buffers can
+    // be shared between the two.
+    static bool matches(void* cfg) {
+        return cfg && skip_get_cfg_endian(cfg) == Endian &&
+               !skip_get_type_at_index(cfg, sizeof...(Fields)) &&
+               match_fields(cfg, std::index_sequence_for<Fields...>{});
+    }
+};
+
+// The runtime default is host byte order, as with skip_create_base_config.
+template <typename... Fields>
+using Schema = BasicSchema<host_endian, Fields...>;
+
+} // namespace skip
+
+#endif